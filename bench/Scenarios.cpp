@@ -0,0 +1,112 @@
+/**
+ * @file Scenarios.cpp
+ * @brief Scripted benchmark scenarios
+ */
+
+#include "Scenarios.h"
+#include "GmodIndex.h"
+
+#include <imgui.h>
+
+#include <string_view>
+
+using namespace dnv::vista::sdk;
+
+namespace nfx::vista::bench
+{
+    Panels::Panels( const VIS& vis, const VersionStore& versions, ThreadPool& workers )
+        : gmodViewer{ vis, versions, workers },
+          localIdBuilder{ vis, versions, workers },
+          projectManager{ workers }
+    {
+        // Same wiring as Application::connectPanels
+        gmodViewer.setNodeSelectionCallback( [this]( std::optional<GmodPath> path ) {
+            selectedPath = path;
+            nodeDetails.setCurrentGmodPath( path );
+            localIdBuilder.setCurrentGmodPath( path );
+        } );
+    }
+
+    const std::vector<Scenario>& scenarios()
+    {
+        static const std::vector<Scenario> s_scenarios = {
+            {
+                "idle",
+                "All panels open, no input",
+                []( ScenarioContext&, int ) {},
+            },
+            {
+                "expand-subtree",
+                "Reveal the target node: ancestors expanded, tree scrolled to it",
+                []( ScenarioContext& context, int frame ) {
+                    if( frame == 0 )
+                    {
+                        context.panels.gmodViewer.revealNode( context.target, context.entry.version );
+                    }
+                },
+            },
+            {
+                "search",
+                "Type a query in the Gmod search box, one character per frame, overlay open",
+                []( ScenarioContext& context, int frame ) {
+                    constexpr std::string_view query = "engine";
+                    if( frame == 0 )
+                    {
+                        context.panels.gmodViewer.focusSearch();
+                    }
+                    else if( frame <= static_cast<int>( query.size() ) )
+                    {
+                        ImGui::GetIO().AddInputCharacter( static_cast<unsigned int>( query[frame - 1] ) );
+                    }
+                },
+            },
+            {
+                "build-localid",
+                "Select the target node, use it as primary item and fill metadata tags",
+                []( ScenarioContext& context, int frame ) {
+                    auto& panels = context.panels;
+                    if( frame == 0 )
+                    {
+                        panels.gmodViewer.revealNode( context.target, context.entry.version );
+                    }
+                    else if( frame == 1 && panels.selectedPath.has_value() )
+                    {
+                        panels.localIdBuilder.setPrimaryPath( *panels.selectedPath );
+                        panels.localIdBuilder.setMetadataTag( CodebookName::Quantity, "temperature" );
+                        panels.localIdBuilder.setMetadataTag( CodebookName::Position, "inlet" );
+                    }
+                    else if( frame == 2 )
+                    {
+                        // Custom value: exercises the '~' separator path
+                        panels.localIdBuilder.setMetadataTag( CodebookName::Content, "bench.content" );
+                    }
+                },
+            },
+        };
+
+        return s_scenarios;
+    }
+
+    const GmodNode* defaultTarget( const VersionStore::Entry& entry )
+    {
+        const auto& index = *entry.index;
+
+        const GmodNode* deepest = nullptr;
+        uint32_t deepestDepth = 0;
+        for( uint32_t i = 0; i < static_cast<uint32_t>( index.nodeCount() ); ++i )
+        {
+            const GmodNode& node = index.node( i );
+            if( !node.isLeafNode() || index.isStructural( i ) )
+            {
+                continue;
+            }
+            if( !deepest || index.depth( i ) > deepestDepth )
+            {
+                deepest = &node;
+                deepestDepth = index.depth( i );
+            }
+        }
+
+        return deepest;
+    }
+} // namespace nfx::vista::bench
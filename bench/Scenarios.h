@@ -0,0 +1,59 @@
+#pragma once
+
+#include "VersionStore.h"
+#include "panels/GmodViewer.h"
+#include "panels/LocalIdBuilder.h"
+#include "panels/NodeDetails.h"
+#include "panels/ProjectManager.h"
+
+#include <dnv/vista/sdk/VIS.h>
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace nfx::vista::bench
+{
+    /**
+     * @brief The four panels, connected as in the application
+     */
+    struct Panels
+    {
+        Panels( const dnv::vista::sdk::VIS& vis, const VersionStore& versions, ThreadPool& workers );
+
+        GmodViewer gmodViewer;
+        NodeDetails nodeDetails;
+        LocalIdBuilder localIdBuilder;
+        ProjectManager projectManager;
+
+        std::optional<dnv::vista::sdk::GmodPath> selectedPath; ///< Last path selected in the Gmod viewer
+    };
+
+    /**
+     * @brief What a scenario acts on
+     */
+    struct ScenarioContext
+    {
+        Panels& panels;
+        const VersionStore::Entry& entry;
+        const dnv::vista::sdk::GmodNode& target; ///< Node to expand / build a LocalId for
+    };
+
+    /**
+     * @brief Scripted interaction, step() runs before each measured frame
+     */
+    struct Scenario
+    {
+        const char* name;
+        const char* description;
+        std::function<void( ScenarioContext& context, int frame )> step;
+    };
+
+    const std::vector<Scenario>& scenarios();
+
+    /**
+     * @brief Default target: the deepest leaf node of the Gmod
+     */
+    const dnv::vista::sdk::GmodNode* defaultTarget( const VersionStore::Entry& entry );
+} // namespace nfx::vista::bench
@@ -0,0 +1,532 @@
+/**
+ * @file main.cpp
+ * @brief Headless panel benchmark
+ *
+ * Renders the panels through scripted scenarios with an ImGui context that has no window and no
+ * renderer, and reports per-frame CPU time and heap allocations as JSON.
+ * With --check-idle-allocations it doubles as a regression test: any allocation in a measured idle
+ * frame fails the run.
+ */
+
+#include "Scenarios.h"
+
+#include "FrameArena.h"
+#include "GmodIndex.h"
+#include "HeadlessImGui.h"
+#include "ThreadPool.h"
+#include "VersionStore.h"
+#include "diagnostics/AllocationTracker.h"
+#include "diagnostics/FrameProfiler.h"
+
+#include <dnv/vista/sdk/Transport.h>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace dnv::vista::sdk;
+using namespace nfx::vista;
+using namespace nfx::vista::bench;
+
+namespace
+{
+    struct Options
+    {
+        int frames = 300;
+        int warmupFrames = 30;
+        std::vector<std::string> scenarios; ///< Empty = all
+        std::string version;                ///< Empty = latest
+        std::string node;                   ///< Empty = deepest leaf
+        std::string outputPath;             ///< Empty = stdout
+        bool checkIdleAllocations = false;  ///< Fail if a measured idle frame allocates
+        bool list = false;
+    };
+
+    struct FrameSample
+    {
+        double cpuMs;
+        AllocationTracker::Snapshot allocations; ///< Main thread, per subsystem
+    };
+
+    void printUsage( const char* program )
+    {
+        std::cout << "Usage: " << program << " [options]\n"
+                  << "\n"
+                  << "Options:\n"
+                  << "  --frames=N          Measured frames per scenario (default 300)\n"
+                  << "  --warmup=N          Unmeasured frames before each scenario (default 30)\n"
+                  << "  --scenario=NAME     Run only this scenario, repeatable\n"
+                  << "  --version=VERSION   VIS version, e.g. 3-9a (default latest)\n"
+                  << "  --node=CODE         Target node of the scenarios (default deepest leaf)\n"
+                  << "  --output=PATH       Write the JSON report to PATH instead of stdout\n"
+                  << "  --check-idle-allocations\n"
+                  << "                      Run the idle scenario and exit with status 2 if any\n"
+                  << "                      measured frame allocates\n"
+                  << "  --list              List scenarios and exit\n";
+    }
+
+    std::optional<int> parseCount( std::string_view text )
+    {
+        int value = 0;
+        const auto [end, ec] = std::from_chars( text.data(), text.data() + text.size(), value );
+        if( ec != std::errc{} || end != text.data() + text.size() || value < 0 )
+        {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+    std::optional<Options> parseOptions( int argc, char** argv )
+    {
+        Options options;
+
+        for( int i = 1; i < argc; ++i )
+        {
+            const std::string_view arg = argv[i];
+            auto valueOf = [&arg]( std::string_view prefix ) { return arg.substr( prefix.size() ); };
+
+            if( arg.starts_with( "--frames=" ) || arg.starts_with( "--warmup=" ) )
+            {
+                const bool isFrames = arg.starts_with( "--frames=" );
+                const auto count = parseCount( valueOf( isFrames ? "--frames=" : "--warmup=" ) );
+                if( !count.has_value() || ( isFrames && count.value() == 0 ) )
+                {
+                    std::cerr << "Invalid frame count: " << arg << "\n";
+                    return std::nullopt;
+                }
+                ( isFrames ? options.frames : options.warmupFrames ) = count.value();
+            }
+            else if( arg.starts_with( "--scenario=" ) )
+            {
+                options.scenarios.emplace_back( valueOf( "--scenario=" ) );
+            }
+            else if( arg.starts_with( "--version=" ) )
+            {
+                options.version = valueOf( "--version=" );
+            }
+            else if( arg.starts_with( "--node=" ) )
+            {
+                options.node = valueOf( "--node=" );
+            }
+            else if( arg.starts_with( "--output=" ) )
+            {
+                options.outputPath = valueOf( "--output=" );
+            }
+            else if( arg == "--check-idle-allocations" )
+            {
+                options.checkIdleAllocations = true;
+            }
+            else if( arg == "--list" )
+            {
+                options.list = true;
+            }
+            else
+            {
+                std::cerr << "Unknown argument: " << arg << "\n";
+                return std::nullopt;
+            }
+        }
+
+        if( options.checkIdleAllocations )
+        {
+            auto& selected = options.scenarios;
+            if( selected.empty() )
+            {
+                selected.emplace_back( "idle" );
+            }
+            else if( std::find( selected.begin(), selected.end(), "idle" ) == selected.end() )
+            {
+                std::cerr << "--check-idle-allocations requires the idle scenario\n";
+                return std::nullopt;
+            }
+        }
+
+        return options;
+    }
+
+    double percentile( std::vector<double> sorted, double p )
+    {
+        if( sorted.empty() )
+        {
+            return 0.0;
+        }
+        std::sort( sorted.begin(), sorted.end() );
+        return sorted[static_cast<size_t>( p * static_cast<double>( sorted.size() - 1 ) + 0.5 )];
+    }
+
+    /**
+     * @brief Render one frame of all panels, laid out in a 2x2 grid like the default docking layout
+     */
+    void renderPanels( Panels& panels, VisVersion version, FrameProfiler& profiler, ImVec2 displaySize )
+    {
+        using Section = FrameProfiler::Section;
+
+        const ImVec2 half( displaySize.x * 0.5f, displaySize.y * 0.5f );
+        auto place = [&half]( float x, float y ) {
+            ImGui::SetNextWindowPos( ImVec2( x * half.x, y * half.y ), ImGuiCond_Always );
+            ImGui::SetNextWindowSize( half, ImGuiCond_Always );
+        };
+
+        bool gmodViewerVisible = false;
+        {
+            auto timer = profiler.scope( Section::GmodViewer );
+            auto allocations = AllocationTracker::scope( AllocationTag::GmodViewer );
+            place( 1, 0 );
+            gmodViewerVisible = panels.gmodViewer.render( version );
+        }
+        if( gmodViewerVisible )
+        {
+            auto timer = profiler.scope( Section::SearchOverlay );
+            auto allocations = AllocationTracker::scope( AllocationTag::GmodViewer );
+            panels.gmodViewer.renderOverlay( version );
+        }
+        {
+            auto timer = profiler.scope( Section::NodeDetails );
+            auto allocations = AllocationTracker::scope( AllocationTag::NodeDetails );
+            place( 1, 1 );
+            panels.nodeDetails.render();
+        }
+        {
+            auto timer = profiler.scope( Section::LocalIdBuilder );
+            auto allocations = AllocationTracker::scope( AllocationTag::LocalIdBuilder );
+            place( 0, 0 );
+            panels.localIdBuilder.render( version );
+        }
+        {
+            auto timer = profiler.scope( Section::ProjectManager );
+            auto allocations = AllocationTracker::scope( AllocationTag::ProjectManager );
+            place( 0, 1 );
+            panels.projectManager.render();
+        }
+    }
+
+    /**
+     * @brief Run one scenario in a fresh ImGui context and fresh panels
+     * @return Allocations of the measured frames per subsystem
+     */
+    AllocationTracker::Snapshot runScenario(
+        nfx::json::Builder& b,
+        const Scenario& scenario,
+        const Options& options,
+        const VIS& vis,
+        const VersionStore& store,
+        ThreadPool& workers,
+        const VersionStore::Entry& entry,
+        const GmodNode& target )
+    {
+        using Clock = std::chrono::steady_clock;
+        using Section = FrameProfiler::Section;
+
+        const ImVec2 displaySize( 1600.0f, 900.0f );
+        HeadlessImGui imgui( displaySize );
+        auto panels = std::make_unique<Panels>( vis, store, workers );
+        FrameProfiler profiler;
+        ScenarioContext context{ *panels, entry, target };
+
+        std::vector<FrameSample> samples;
+        samples.reserve( static_cast<size_t>( options.frames ) );
+
+        for( int frame = -options.warmupFrames; frame < options.frames; ++frame )
+        {
+            const bool measured = frame >= 0;
+            if( measured )
+            {
+                scenario.step( context, frame );
+            }
+
+            // Results requested by the previous frame (search, parses) are published before this one,
+            // so every run draws the same frames; worker time is not part of the frame time
+            workers.waitIdle();
+
+            const auto allocationsBefore = AllocationTracker::thread();
+            const auto start = Clock::now();
+            {
+                auto timer = profiler.scope( Section::Frame );
+                {
+                    auto newFrame = profiler.scope( Section::NewFrame );
+                    FrameArena::reset();
+                    imgui.newFrame();
+                }
+                renderPanels( *panels, entry.version, profiler, displaySize );
+                {
+                    auto submit = profiler.scope( Section::Submit );
+                    imgui.render();
+                }
+            }
+            const auto end = Clock::now();
+            const auto allocationsAfter = AllocationTracker::thread();
+            AllocationTracker::Snapshot allocations;
+            for( size_t i = 0; i < AllocationTracker::k_tagCount; ++i )
+            {
+                allocations[i] = allocationsAfter[i] - allocationsBefore[i];
+            }
+
+            if( measured )
+            {
+                profiler.endFrame( true );
+                samples.push_back(
+                    FrameSample{ std::chrono::duration<double, std::milli>( end - start ).count(), allocations } );
+            }
+            else
+            {
+                // Warm-up frames must not show up in the section percentiles
+                profiler = FrameProfiler{};
+            }
+        }
+
+        std::vector<double> cpuMs;
+        uint64_t totalAllocations = 0;
+        uint64_t totalBytes = 0;
+        uint64_t maxAllocations = 0;
+        AllocationTracker::Snapshot bySubsystem{};
+        for( const auto& s : samples )
+        {
+            const auto frame = AllocationTracker::total( s.allocations );
+            cpuMs.push_back( s.cpuMs );
+            totalAllocations += frame.count;
+            totalBytes += frame.bytes;
+            maxAllocations = std::max( maxAllocations, frame.count );
+            for( size_t i = 0; i < AllocationTracker::k_tagCount; ++i )
+            {
+                bySubsystem[i] += s.allocations[i];
+            }
+        }
+        const double frames = static_cast<double>( samples.size() );
+
+        b.writeStartObject();
+        b.write( "name", std::string( scenario.name ) );
+        b.write( "description", std::string( scenario.description ) );
+
+        // --- summary ---
+        b.writeKey( "cpuMs" );
+        b.writeStartObject();
+        b.write( "mean", std::accumulate( cpuMs.begin(), cpuMs.end(), 0.0 ) / frames );
+        b.write( "p50", percentile( cpuMs, 0.50 ) );
+        b.write( "p95", percentile( cpuMs, 0.95 ) );
+        b.write( "p99", percentile( cpuMs, 0.99 ) );
+        b.write( "max", *std::max_element( cpuMs.begin(), cpuMs.end() ) );
+        b.writeEndObject();
+
+        b.writeKey( "allocations" );
+        b.writeStartObject();
+        b.write( "total", totalAllocations );
+        b.write( "bytes", totalBytes );
+        b.write( "perFrameMean", static_cast<double>( totalAllocations ) / frames );
+        b.write( "perFrameMax", maxAllocations );
+        b.write( "frameArenaPeakBytes", static_cast<uint64_t>( FrameArena::peak() ) );
+        b.writeKey( "bySubsystem" );
+        b.writeStartObject();
+        for( size_t i = 0; i < AllocationTracker::k_tagCount; ++i )
+        {
+            b.writeKey( AllocationTracker::name( static_cast<AllocationTag>( i ) ) );
+            b.writeStartObject();
+            b.write( "total", bySubsystem[i].count );
+            b.write( "bytes", bySubsystem[i].bytes );
+            b.writeEndObject();
+        }
+        b.writeEndObject();
+        b.writeEndObject();
+
+        // --- per section, over the last FrameProfiler::k_historySize frames ---
+        b.writeKey( "sections" );
+        b.writeStartArray();
+        for( size_t i = 0; i < static_cast<size_t>( Section::Count ); ++i )
+        {
+            const auto section = static_cast<Section>( i );
+            const auto stats = profiler.stats( section );
+            if( stats.samples == 0 )
+            {
+                continue;
+            }
+            b.writeStartObject();
+            b.write( "name", std::string( FrameProfiler::name( section ) ) );
+            b.write( "p50", static_cast<double>( stats.p50 ) );
+            b.write( "p95", static_cast<double>( stats.p95 ) );
+            b.write( "p99", static_cast<double>( stats.p99 ) );
+            b.write( "max", static_cast<double>( stats.max ) );
+            b.writeEndObject();
+        }
+        b.writeEndArray();
+
+        // --- per frame ---
+        b.writeKey( "frames" );
+        b.writeStartObject();
+        b.writeKey( "cpuMs" );
+        b.writeStartArray();
+        for( const auto& s : samples )
+        {
+            b.write( s.cpuMs );
+        }
+        b.writeEndArray();
+        b.writeKey( "allocations" );
+        b.writeStartArray();
+        for( const auto& s : samples )
+        {
+            b.write( AllocationTracker::total( s.allocations ).count );
+        }
+        b.writeEndArray();
+        b.writeKey( "allocatedBytes" );
+        b.writeStartArray();
+        for( const auto& s : samples )
+        {
+            b.write( AllocationTracker::total( s.allocations ).bytes );
+        }
+        b.writeEndArray();
+        b.writeEndObject();
+
+        b.writeEndObject();
+
+        return bySubsystem;
+    }
+} // namespace
+
+int main( int argc, char** argv )
+{
+    const auto options = parseOptions( argc, argv );
+    if( !options.has_value() )
+    {
+        printUsage( argv[0] );
+        return 1;
+    }
+
+    if( options->list )
+    {
+        for( const auto& scenario : scenarios() )
+        {
+            std::cout << scenario.name << " - " << scenario.description << "\n";
+        }
+        return 0;
+    }
+
+    // --- VIS data ---
+    const VIS& vis = VIS::instance();
+
+    std::optional<VisVersion> version;
+    for( const auto v : vis.versions() )
+    {
+        if( options->version.empty() || VisVersions::toString( v ) == options->version )
+        {
+            version = v;
+        }
+    }
+    if( !version.has_value() )
+    {
+        std::cerr << "Unknown VIS version: " << options->version << "\n";
+        return 1;
+    }
+
+    ThreadPool workers;
+    VersionStore store( vis, workers );
+    store.preloadAll();
+
+    while( !store.isReady( *version ) && store.state( *version ) != VersionStore::State::Failed )
+    {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    }
+
+    const auto* entry = store.find( *version );
+    if( !entry )
+    {
+        std::cerr << "Failed to load VIS " << VisVersions::toString( *version ) << "\n";
+        return 1;
+    }
+
+    // Let the other versions finish loading so the workers are idle while measuring
+    while( store.isLoading() )
+    {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    }
+
+    const GmodNode* target = nullptr;
+    if( options->node.empty() )
+    {
+        target = defaultTarget( *entry );
+    }
+    else if( const auto nodeIndex = entry->index->indexOf( options->node ) )
+    {
+        target = &entry->index->node( *nodeIndex );
+    }
+    if( !target )
+    {
+        std::cerr << "Unknown node: " << options->node << "\n";
+        return 1;
+    }
+
+    // --- scenarios ---
+    nfx::json::Builder b( { .indent = 2 } );
+
+    b.writeStartObject();
+    b.write( "version", std::string( VisVersions::toString( *version ) ) );
+    b.write( "target", std::string( target->code() ) );
+    b.write( "frames", options->frames );
+    b.write( "warmupFrames", options->warmupFrames );
+
+    std::optional<AllocationTracker::Snapshot> idleAllocations;
+
+    b.writeKey( "scenarios" );
+    b.writeStartArray();
+    for( const auto& scenario : scenarios() )
+    {
+        const auto& selected = options->scenarios;
+        if( !selected.empty() && std::find( selected.begin(), selected.end(), scenario.name ) == selected.end() )
+        {
+            continue;
+        }
+
+        std::cerr << "Running " << scenario.name << "...\n";
+        const auto allocations = runScenario( b, scenario, *options, vis, store, workers, *entry, *target );
+        if( std::string_view{ scenario.name } == "idle" )
+        {
+            idleAllocations = allocations;
+        }
+    }
+    b.writeEndArray();
+
+    b.writeEndObject();
+
+    if( options->outputPath.empty() )
+    {
+        std::cout << b.toString() << "\n";
+    }
+    else
+    {
+        std::ofstream f( options->outputPath );
+        if( !f )
+        {
+            std::cerr << "Failed to write " << options->outputPath << "\n";
+            return 1;
+        }
+        f << b.toString() << "\n";
+    }
+
+    if( options->checkIdleAllocations && idleAllocations.has_value() )
+    {
+        const auto total = AllocationTracker::total( *idleAllocations );
+        if( total.count > 0 )
+        {
+            std::cerr << "FAILED: " << total.count << " allocations (" << total.bytes << " bytes) in "
+                      << options->frames << " idle frames\n";
+            for( size_t i = 0; i < AllocationTracker::k_tagCount; ++i )
+            {
+                const auto& stats = ( *idleAllocations )[i];
+                if( stats.count > 0 )
+                {
+                    std::cerr << "  " << AllocationTracker::name( static_cast<AllocationTag>( i ) ) << ": "
+                              << stats.count << " (" << stats.bytes << " bytes)\n";
+                }
+            }
+            return 2;
+        }
+        std::cerr << "Idle frames allocation-free\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file LinePipeline.cpp
+ * @brief Ordered, multithreaded line streaming
+ */
+
+#include "LinePipeline.h"
+#include "LocalIdText.h"
+#include "diagnostics/Tracer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+
+namespace nfx::vista::cli
+{
+    namespace
+    {
+        struct Block
+        {
+            std::string text; // Whole lines only
+            size_t firstLine = 1;
+            std::string out;
+            std::string diagnostics;
+            size_t lines = 0;
+            size_t failed = 0;
+            bool done = false; // Guarded by the pipeline mutex
+        };
+    } // namespace
+
+    LinePipeline::LinePipeline( ThreadPool& workers, Transform transform, size_t blockSize )
+        : m_workers{ workers },
+          m_transform{ std::move( transform ) },
+          m_blockSize{ std::max<size_t>( blockSize, 1 ) }
+    {
+    }
+
+    LinePipeline::Stats LinePipeline::run( std::istream& in, std::ostream& out, std::ostream& diagnostics )
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const size_t maxInFlight = std::max<size_t>( m_workers.threadCount(), 1 ) * 4;
+
+        Stats stats;
+        std::mutex mutex;
+        std::condition_variable blockDone;
+        std::deque<std::shared_ptr<Block>> inFlight;
+
+        auto writeOldest = [&]() {
+            std::shared_ptr<Block> block = std::move( inFlight.front() );
+            inFlight.pop_front();
+            {
+                std::unique_lock lock( mutex );
+                blockDone.wait( lock, [&block]() { return block->done; } );
+            }
+
+            out.write( block->out.data(), static_cast<std::streamsize>( block->out.size() ) );
+            diagnostics.write( block->diagnostics.data(), static_cast<std::streamsize>( block->diagnostics.size() ) );
+            stats.lines += block->lines;
+            stats.failed += block->failed;
+        };
+
+        std::string carry; // Partial last line of the previous read
+        size_t nextLine = 1;
+        bool eof = false;
+        while( !eof )
+        {
+            auto block = std::make_shared<Block>();
+            block->text = std::move( carry );
+            carry.clear();
+
+            // Read until the block holds at least one line end, a line longer than a block grows it
+            size_t cut = std::string::npos;
+            while( cut == std::string::npos )
+            {
+                const size_t previous = block->text.size();
+                block->text.resize( previous + m_blockSize );
+                in.read( block->text.data() + previous, static_cast<std::streamsize>( m_blockSize ) );
+                block->text.resize( previous + static_cast<size_t>( in.gcount() ) );
+                if( !in )
+                {
+                    eof = true;
+                    break;
+                }
+                cut = block->text.rfind( '\n' );
+            }
+            if( !eof )
+            {
+                carry.assign( block->text, cut + 1 );
+                block->text.resize( cut + 1 );
+            }
+            if( block->text.empty() )
+            {
+                break;
+            }
+
+            stats.bytes += block->text.size();
+            block->firstLine = nextLine;
+            nextLine += static_cast<size_t>( std::count( block->text.begin(), block->text.end(), '\n' ) );
+
+            m_workers.submit( [this, block, &mutex, &blockDone]() {
+                auto trace = Tracer::scope( "LinePipeline::block", "cli" );
+                forEachLine( block->text, [this, &block]( std::string_view line, size_t lineNumber ) {
+                    ++block->lines;
+                    if( !m_transform( line, block->firstLine + lineNumber - 1, block->out, block->diagnostics ) )
+                    {
+                        ++block->failed;
+                    }
+                } );
+
+                std::lock_guard lock( mutex );
+                block->done = true;
+                blockDone.notify_all();
+            } );
+            inFlight.push_back( std::move( block ) );
+
+            // Write whatever is ready in order; wait for the oldest only when the window is full
+            while( !inFlight.empty() )
+            {
+                bool oldestDone = false;
+                {
+                    std::lock_guard lock( mutex );
+                    oldestDone = inFlight.front()->done;
+                }
+                if( !oldestDone && inFlight.size() < maxInFlight )
+                {
+                    break;
+                }
+                writeOldest();
+            }
+        }
+
+        while( !inFlight.empty() )
+        {
+            writeOldest();
+        }
+        out.flush();
+        diagnostics.flush();
+
+        stats.seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+        return stats;
+    }
+} // namespace nfx::vista::cli
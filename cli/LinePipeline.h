@@ -0,0 +1,51 @@
+#pragma once
+
+#include "ThreadPool.h"
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+namespace nfx::vista::cli
+{
+    /**
+     * @brief Streams lines through a transform on the worker pool and writes the results in input order
+     * @details Input is read in blocks cut at a line end; each block is one task whose lines are split as views
+     *          into it (forEachLine) and transformed into the block's own output buffers. The oldest block is
+     *          written as soon as it is done, and reading pauses while too many blocks are in flight, so memory
+     *          stays bounded however long the stream is.
+     */
+    class LinePipeline
+    {
+    public:
+        static constexpr size_t k_defaultBlockSize = 256 * 1024;
+
+        /**
+         * @brief Transform of one non-blank, trimmed line, called concurrently from the workers
+         * @param out Appended to the output, in line order
+         * @param diagnostics Appended to the diagnostics stream, in line order
+         * @return false when the line failed
+         */
+        using Transform = std::function<bool(
+            std::string_view line, size_t lineNumber, std::string& out, std::string& diagnostics )>;
+
+        struct Stats
+        {
+            size_t lines = 0;
+            size_t failed = 0;
+            size_t bytes = 0;
+            double seconds = 0.0;
+        };
+
+        LinePipeline( ThreadPool& workers, Transform transform, size_t blockSize = k_defaultBlockSize );
+
+        Stats run( std::istream& in, std::ostream& out, std::ostream& diagnostics );
+
+    private:
+        ThreadPool& m_workers;
+        Transform m_transform;
+        size_t m_blockSize;
+    };
+} // namespace nfx::vista::cli
@@ -0,0 +1,394 @@
+/**
+ * @file main.cpp
+ * @brief Headless LocalId tool
+ *
+ * Streams LocalIds or Gmod paths from stdin to stdout, one per line, using the same LocalId and path
+ * code as the explorer's panels but no window, ImGui or OpenGL. Lines are processed in parallel and
+ * written in input order.
+ */
+
+#include "LinePipeline.h"
+
+#include "CodebookCache.h"
+#include "LocalIdText.h"
+#include "ThreadPool.h"
+
+#include <dnv/vista/sdk/VIS.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+using namespace dnv::vista::sdk;
+using namespace nfx::vista;
+using namespace nfx::vista::cli;
+
+namespace
+{
+    struct Options
+    {
+        std::string command;      ///< validate, normalize or build
+        std::string version;      ///< build: empty = latest
+        bool verbose = false;     ///< build: common names in the item paths
+        MetadataTags tags;        ///< build: added to every LocalId
+        bool invalidOnly = false; ///< validate: print only the invalid lines
+        size_t threads = 0;       ///< 0 = one per hardware thread
+        bool stats = false;       ///< Print throughput to stderr at the end
+        bool showHelp = false;
+    };
+
+    struct TagOption
+    {
+        std::string_view prefix;
+        std::string MetadataTags::* value;
+    };
+
+    constexpr std::array<TagOption, 8> k_tagOptions{ {
+        { "--quantity=", &MetadataTags::quantity },
+        { "--content=", &MetadataTags::content },
+        { "--position=", &MetadataTags::position },
+        { "--calculation=", &MetadataTags::calculation },
+        { "--state=", &MetadataTags::state },
+        { "--command=", &MetadataTags::command },
+        { "--type=", &MetadataTags::type },
+        { "--detail=", &MetadataTags::detail },
+    } };
+
+    void printUsage( const char* program )
+    {
+        std::cout << "Usage: " << program << " <command> [options] < input > output\n"
+                  << "\n"
+                  << "Commands (one item per input line, blank lines skipped):\n"
+                  << "  validate            Print 'valid<TAB>localId' or 'invalid<TAB>localId<TAB>errors'\n"
+                  << "  normalize           Print each LocalId as the SDK writes it; invalid lines go to stderr\n"
+                  << "  build               Print the LocalId of 'primary[<TAB>secondary[<TAB>location]]' short\n"
+                  << "                      paths, the location is applied to the primary item; invalid lines\n"
+                  << "                      go to stderr\n"
+                  << "\n"
+                  << "Options:\n"
+                  << "  --invalid-only      validate: print only the invalid lines\n"
+                  << "  --version=VERSION   build: VIS version, e.g. 3-9a (default latest)\n"
+                  << "  --verbose           build: common names in the item paths\n"
+                  << "  --quantity=VALUE    build: metadata tag added to every LocalId, likewise --content,\n"
+                  << "                      --position, --calculation, --state, --command, --type, --detail\n"
+                  << "  --threads=N         Worker threads (default one per hardware thread)\n"
+                  << "  --stats             Print line count and throughput to stderr\n"
+                  << "\n"
+                  << "Exit status is 2 when any line is invalid.\n";
+    }
+
+    std::optional<size_t> parseSize( std::string_view text )
+    {
+        size_t value = 0;
+        const auto [end, ec] = std::from_chars( text.data(), text.data() + text.size(), value );
+        if( ec != std::errc{} || end != text.data() + text.size() )
+        {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+    std::optional<Options> parseOptions( int argc, char** argv )
+    {
+        Options options;
+
+        for( int i = 1; i < argc; ++i )
+        {
+            const std::string_view arg = argv[i];
+            auto valueOf = [&arg]( std::string_view prefix ) { return arg.substr( prefix.size() ); };
+
+            if( arg == "--help" || arg == "-h" )
+            {
+                options.showHelp = true;
+            }
+            else if( !arg.starts_with( "-" ) && options.command.empty() )
+            {
+                if( arg != "validate" && arg != "normalize" && arg != "build" )
+                {
+                    std::cerr << "Unknown command: " << arg << "\n";
+                    return std::nullopt;
+                }
+                options.command = arg;
+            }
+            else if( arg == "--invalid-only" )
+            {
+                options.invalidOnly = true;
+            }
+            else if( arg.starts_with( "--version=" ) )
+            {
+                options.version = valueOf( "--version=" );
+            }
+            else if( arg == "--verbose" )
+            {
+                options.verbose = true;
+            }
+            else if( arg.starts_with( "--threads=" ) )
+            {
+                const auto threads = parseSize( valueOf( "--threads=" ) );
+                if( !threads.has_value() || threads.value() == 0 )
+                {
+                    std::cerr << "Invalid thread count: " << arg << "\n";
+                    return std::nullopt;
+                }
+                options.threads = threads.value();
+            }
+            else if( arg == "--stats" )
+            {
+                options.stats = true;
+            }
+            else
+            {
+                const auto tag = std::find_if( k_tagOptions.begin(), k_tagOptions.end(), [&arg]( const TagOption& t ) {
+                    return arg.starts_with( t.prefix );
+                } );
+                if( tag == k_tagOptions.end() )
+                {
+                    std::cerr << "Unknown argument: " << arg << "\n";
+                    return std::nullopt;
+                }
+                options.tags.*( tag->value ) = valueOf( tag->prefix );
+            }
+        }
+
+        if( options.command.empty() && !options.showHelp )
+        {
+            std::cerr << "Missing command\n";
+            return std::nullopt;
+        }
+
+        return options;
+    }
+
+    void appendMessages( std::string& out, const ParsingErrors& errors, std::string_view fallback )
+    {
+        bool first = true;
+        for( const auto& [type, message] : errors )
+        {
+            if( !first )
+            {
+                out += "; ";
+            }
+            out += message;
+            first = false;
+        }
+        if( first )
+        {
+            out += fallback;
+        }
+    }
+
+    void appendLineError( std::string& diagnostics, size_t lineNumber, std::string_view what, std::string_view message )
+    {
+        diagnostics += "line ";
+        diagnostics += std::to_string( lineNumber );
+        diagnostics += ": ";
+        diagnostics += what;
+        diagnostics += ": ";
+        diagnostics += message;
+        diagnostics += '\n';
+    }
+
+    void appendLineError(
+        std::string& diagnostics, size_t lineNumber, std::string_view what, const ParsingErrors& errors )
+    {
+        std::string message;
+        appendMessages( message, errors, "invalid" );
+        appendLineError( diagnostics, lineNumber, what, message );
+    }
+
+    LinePipeline::Transform validate( bool invalidOnly )
+    {
+        return [invalidOnly]( std::string_view line, size_t, std::string& out, std::string& ) {
+            ParsingErrors errors;
+            if( LocalId::fromString( line, errors ).has_value() )
+            {
+                if( !invalidOnly )
+                {
+                    out += "valid\t";
+                    out += line;
+                    out += '\n';
+                }
+                return true;
+            }
+
+            out += "invalid\t";
+            out += line;
+            out += '\t';
+            appendMessages( out, errors, "Invalid LocalId" );
+            out += '\n';
+            return false;
+        };
+    }
+
+    LinePipeline::Transform normalize()
+    {
+        return []( std::string_view line, size_t lineNumber, std::string& out, std::string& diagnostics ) {
+            ParsingErrors errors;
+            const auto localId = LocalId::fromString( line, errors );
+            if( !localId.has_value() )
+            {
+                appendLineError( diagnostics, lineNumber, "LocalId", errors );
+                return false;
+            }
+
+            out += localId->toString();
+            out += '\n';
+            return true;
+        };
+    }
+
+    /**
+     * @brief LocalIds composed as the builder panel does, from tab-separated short paths
+     */
+    LinePipeline::Transform build( const VIS& vis, VisVersion version, const Options& options )
+    {
+        const Gmod& gmod = vis.gmod( version );
+        const Locations& locations = vis.locations( version );
+        std::shared_ptr<const CodebookCache> codebooks = CodebookCache::build( vis.codebooks( version ) );
+
+        return [&gmod, &locations, codebooks, version, verbose = options.verbose, tags = options.tags](
+                   std::string_view line, size_t lineNumber, std::string& out, std::string& diagnostics ) {
+            // primary[\tsecondary[\tlocation]]
+            std::array<std::string_view, 3> columns{};
+            size_t count = 0;
+            for( size_t pos = 0; pos <= line.size(); )
+            {
+                size_t end = line.find( '\t', pos );
+                if( end == std::string_view::npos )
+                {
+                    end = line.size();
+                }
+                if( count == columns.size() )
+                {
+                    diagnostics += "line " + std::to_string( lineNumber ) + ": too many columns\n";
+                    return false;
+                }
+                columns[count++] = line.substr( pos, end - pos );
+                pos = end + 1;
+            }
+            const auto [primaryText, secondaryText, location] = columns;
+
+            ParsingErrors errors;
+            auto primary = GmodPath::fromShortPath( primaryText, gmod, locations, errors );
+            if( !primary.has_value() )
+            {
+                appendLineError( diagnostics, lineNumber, "primary", errors );
+                return false;
+            }
+
+            std::string locatedText;
+            if( !location.empty() )
+            {
+                auto located = applyLocation( *primary, location );
+                if( !located.has_value() )
+                {
+                    appendLineError( diagnostics, lineNumber, "location", "primary item has no individualizable node" );
+                    return false;
+                }
+                locatedText = std::move( *located );
+                ParsingErrors locationErrors;
+                primary = GmodPath::fromShortPath( locatedText, gmod, locations, locationErrors );
+                if( !primary.has_value() )
+                {
+                    appendLineError( diagnostics, lineNumber, "location", locationErrors );
+                    return false;
+                }
+            }
+
+            std::optional<GmodPath> secondary;
+            if( !secondaryText.empty() )
+            {
+                ParsingErrors secondaryErrors;
+                secondary = GmodPath::fromShortPath( secondaryText, gmod, locations, secondaryErrors );
+                if( !secondary.has_value() )
+                {
+                    appendLineError( diagnostics, lineNumber, "secondary", secondaryErrors );
+                    return false;
+                }
+            }
+
+            LocalIdParts parts{ version };
+            parts.primaryText = location.empty() ? primaryText : std::string_view{ locatedText };
+            parts.primary = &*primary;
+            parts.secondaryText = secondaryText;
+            parts.secondary = secondary ? &*secondary : nullptr;
+            parts.verbose = verbose;
+            parts.tags = &tags;
+
+            thread_local std::string localId; // Keeps its capacity across lines
+            composeLocalId( parts, codebooks.get(), localId );
+            out += localId;
+            out += '\n';
+            return true;
+        };
+    }
+} // namespace
+
+int main( int argc, char** argv )
+{
+    const auto options = parseOptions( argc, argv );
+    if( !options.has_value() )
+    {
+        printUsage( argv[0] );
+        return 1;
+    }
+
+    if( options->showHelp )
+    {
+        printUsage( argv[0] );
+        return 0;
+    }
+
+    std::ios::sync_with_stdio( false );
+    std::cin.tie( nullptr );
+
+    const VIS& vis = VIS::instance();
+    ThreadPool workers( options->threads );
+
+    LinePipeline::Transform transform;
+    if( options->command == "validate" )
+    {
+        transform = validate( options->invalidOnly );
+    }
+    else if( options->command == "normalize" )
+    {
+        transform = normalize();
+    }
+    else
+    {
+        std::optional<VisVersion> version;
+        for( const auto v : vis.versions() )
+        {
+            if( options->version.empty() || VisVersions::toString( v ) == options->version )
+            {
+                version = v;
+            }
+        }
+        if( !version.has_value() )
+        {
+            std::cerr << "Unknown VIS version: " << options->version << "\n";
+            return 1;
+        }
+
+        transform = build( vis, *version, *options );
+    }
+
+    LinePipeline pipeline( workers, std::move( transform ) );
+    const auto stats = pipeline.run( std::cin, std::cout, std::cerr );
+
+    if( options->stats )
+    {
+        const double megabytes = static_cast<double>( stats.bytes ) / ( 1024.0 * 1024.0 );
+        const double linesPerSecond = stats.seconds > 0.0 ? static_cast<double>( stats.lines ) / stats.seconds : 0.0;
+        std::cerr << stats.lines << " lines, " << stats.failed << " invalid, " << megabytes << " MB in "
+                  << stats.seconds << " s (" << static_cast<size_t>( linesPerSecond ) << " lines/s, "
+                  << workers.threadCount() << " threads)\n";
+    }
+
+    return stats.failed > 0 ? 2 : 0;
+}
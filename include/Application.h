@@ -1,12 +1,18 @@
 #pragma once
 
+#include "LaunchOptions.h"
 #include "RenderingMode.h"
+#include "diagnostics/FrameProfiler.h"
+#include "diagnostics/StartupProfiler.h"
+#include "panels/PanelVisibility.h"
 
 #include <dnv/vista/sdk/VIS.h>
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 struct GLFWwindow;
 
@@ -15,12 +21,19 @@ namespace nfx::vista
     class GmodViewer;
     class NodeDetails;
     class LocalIdBuilder;
+    class LocalIdInspector;
     class ProjectManager;
+    class Diagnostics;
+    class HeadlessImGui;
+    class InputRecorder;
+    class InputReplay;
+    class ThreadPool;
+    class VersionStore;
 
     class Application
     {
     public:
-        Application();
+        explicit Application( const LaunchOptions& options );
         ~Application();
         Application( const Application& ) = delete;
         Application& operator=( const Application& ) = delete;
@@ -29,11 +42,13 @@ namespace nfx::vista
         void run();
 
     private:
+        void initializeVersionStore();
         bool initializeWindow();
         bool initializeImGui();
 
         void initializePanels();
         void initializeStatus();
+        bool initializeInput();
 
         void connectPanels();
 
@@ -43,13 +58,31 @@ namespace nfx::vista
 
         void renderMenuBar();
         void renderPanels();
+        void renderLoadingPanel( const char* name );
         void renderStatusBar();
 
+        bool isRunning() const;
+        void requestQuit();
         void shutdown();
 
+        void renderResidencyStatus();
+        void prefetchAround( dnv::vista::sdk::VisVersion version );
+        void writeStartupReport();
+        void waitForPendingLoads();
+        void finishReplay();
+
         void calcFps();
         void setupDefaultLayout( unsigned int dockspaceId );
 
+        // First member: its clock starts before anything else is constructed
+        struct
+        {
+            StartupProfiler profiler;
+            bool reported = false;
+        } m_startup;
+
+        LaunchOptions m_options;
+
         struct
         {
             GLFWwindow* handle = nullptr;
@@ -61,6 +94,8 @@ namespace nfx::vista
             const dnv::vista::sdk::VIS* instance;
             dnv::vista::sdk::VisVersion currentVersion;
             int versionIndex;
+            std::unique_ptr<VersionStore> store;
+            bool prefetchAfterSwitch = false;
         } m_vis;
 
         struct
@@ -68,7 +103,9 @@ namespace nfx::vista
             std::unique_ptr<GmodViewer> gmodViewer;
             std::unique_ptr<NodeDetails> nodeDetails;
             std::unique_ptr<LocalIdBuilder> localIdBuilder;
+            std::unique_ptr<LocalIdInspector> localIdInspector;
             std::unique_ptr<ProjectManager> projectManager;
+            std::unique_ptr<Diagnostics> diagnostics;
         } m_panels;
 
         struct
@@ -76,12 +113,27 @@ namespace nfx::vista
             bool showGmodViewer = true;
             bool showNodeDetails = true;
             bool showLocalIdBuilder = true;
+            bool showLocalIdInspector = true;
             bool showProjectManager = true;
+            bool showDiagnostics = false;
         } m_ui;
 
+        // Result of each panel's last render, only panels with model work to skip
+        struct
+        {
+            PanelVisibility gmodViewer;
+            PanelVisibility nodeDetails;
+            PanelVisibility localIdBuilder;
+            PanelVisibility projectManager;
+        } m_visibility;
+
         struct
         {
             RenderingMode mode;
+            FrameProfiler profiler;
+            std::optional<uint64_t> presentedHash; ///< Draw data of the frame on screen
+            bool forceRedraw = true;               ///< Window contents damaged, present even if identical
+            bool lastFramePresented = true;
             double lastFrameTime = 0.0;
             double fps = 0.0;
         } m_rendering;
@@ -91,7 +143,6 @@ namespace nfx::vista
             float height = 25.f;
             std::string rendererName;
             std::string glVersion;
-            size_t nodeCount = 0;
         } m_status;
 
         struct
@@ -99,6 +150,17 @@ namespace nfx::vista
             bool resetRequested = true;
         } m_layout;
 
+        struct
+        {
+            std::unique_ptr<InputRecorder> recorder;
+            std::unique_ptr<InputReplay> replay;
+            std::unique_ptr<HeadlessImGui> headless; ///< Replaces the GLFW/OpenGL backends with --headless
+            std::vector<float> frameMs;              ///< CPU time of every replayed frame
+        } m_input;
+
         std::optional<dnv::vista::sdk::GmodPath> m_currentGmodPath;
+
+        // Declared last: workers are joined before the data they fill is destroyed
+        std::unique_ptr<ThreadPool> m_workers;
     };
 } // namespace nfx::vista
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace nfx::vista
+{
+    /**
+     * @brief Latest immutable result of a computation that runs on the worker pool
+     * @details Double-buffered: render() reads the published value while a worker builds the next one,
+     *          and publishing swaps a shared_ptr under a short lock, so the UI never waits on the work.
+     *          Each request() supersedes the earlier ones: superseded tasks still queued are skipped and
+     *          results that finish out of order are dropped, so the published value only moves forward.
+     *
+     *          The compute function runs on a worker: it must own copies of its inputs (or reference
+     *          immutable data such as the VIS objects) and must not throw. Queued tasks share the state,
+     *          so destroying the snapshot while a task runs is safe.
+     */
+    template <typename T>
+    class AsyncSnapshot
+    {
+    public:
+        explicit AsyncSnapshot( ThreadPool& workers )
+            : m_workers{ workers },
+              m_state{ std::make_shared<State>() }
+        {
+        }
+
+        AsyncSnapshot( const AsyncSnapshot& ) = delete;
+        AsyncSnapshot& operator=( const AsyncSnapshot& ) = delete;
+
+        /**
+         * @brief Called on the worker after each publish, typically to wake the event loop
+         */
+        void setNotifier( std::function<void()> notifier )
+        {
+            std::lock_guard lock( m_state->mutex );
+            m_state->notifier = std::move( notifier );
+        }
+
+        void request( std::function<T()> compute )
+        {
+            const uint64_t generation = m_state->requested.fetch_add( 1, std::memory_order_relaxed ) + 1;
+
+            auto task = [state = m_state, generation, compute = std::move( compute )]() {
+                if( state->requested.load( std::memory_order_relaxed ) == generation )
+                {
+                    state->publish( generation, std::make_shared<const T>( compute() ) );
+                }
+                state->finish( generation );
+            };
+            m_workers.submit( std::move( task ), ThreadPool::Priority::Interactive );
+        }
+
+        /**
+         * @brief Most recent published value, nullptr before the first one
+         */
+        std::shared_ptr<const T> latest() const
+        {
+            std::lock_guard lock( m_state->mutex );
+            return m_state->published;
+        }
+
+        /**
+         * @brief A requested value has not been published yet
+         */
+        bool pending() const
+        {
+            std::lock_guard lock( m_state->mutex );
+            return m_state->finished != m_state->requested.load( std::memory_order_relaxed );
+        }
+
+    private:
+        struct State
+        {
+            std::atomic<uint64_t> requested{ 0 };
+            std::mutex mutex;
+            std::shared_ptr<const T> published;
+            uint64_t publishedGeneration = 0;
+            uint64_t finished = 0; ///< Highest generation whose task ran or was skipped
+            std::function<void()> notifier;
+
+            void publish( uint64_t generation, std::shared_ptr<const T> value )
+            {
+                std::function<void()> notify;
+                {
+                    std::lock_guard lock( mutex );
+                    if( generation <= publishedGeneration )
+                    {
+                        return;
+                    }
+                    published = std::move( value );
+                    publishedGeneration = generation;
+                    notify = notifier;
+                }
+                if( notify )
+                {
+                    notify();
+                }
+            }
+
+            void finish( uint64_t generation )
+            {
+                std::lock_guard lock( mutex );
+                if( generation > finished )
+                {
+                    finished = generation;
+                }
+            }
+        };
+
+        ThreadPool& m_workers;
+        std::shared_ptr<State> m_state;
+    };
+} // namespace nfx::vista
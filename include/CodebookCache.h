@@ -0,0 +1,92 @@
+#pragma once
+
+#include <dnv/vista/sdk/VIS.h>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace nfx::vista
+{
+    /**
+     * @brief Derived per-version view of the codebooks used for metadata tags
+     * @details Built once per version on a VersionStore worker and immutable afterwards, so panels and
+     *          batch tooling share one instance per version without locking. Holds each codebook's
+     *          standard values sorted for display, in a hash set for the '-' / '~' separator choice and
+     *          as a lowercase corpus for the picker's filter.
+     */
+    class CodebookCache
+    {
+    public:
+        /**
+         * @brief Codebooks a LocalId metadata tag can refer to, in builder order
+         */
+        static constexpr std::array<dnv::vista::sdk::CodebookName, 8> k_tagCodebooks = {
+            dnv::vista::sdk::CodebookName::Quantity,
+            dnv::vista::sdk::CodebookName::Content,
+            dnv::vista::sdk::CodebookName::Position,
+            dnv::vista::sdk::CodebookName::Calculation,
+            dnv::vista::sdk::CodebookName::State,
+            dnv::vista::sdk::CodebookName::Command,
+            dnv::vista::sdk::CodebookName::Type,
+            dnv::vista::sdk::CodebookName::Detail,
+        };
+
+        static std::shared_ptr<const CodebookCache> build( const dnv::vista::sdk::Codebooks& codebooks );
+
+        /**
+         * @brief Standard values in lexicographic order, empty for codebooks outside k_tagCodebooks
+         */
+        const std::vector<std::string>& sortedValues( dnv::vista::sdk::CodebookName codebook ) const;
+
+        /**
+         * @brief O(1): whether a value is one of the codebook's standard values
+         */
+        bool isStandardValue( dnv::vista::sdk::CodebookName codebook, std::string_view value ) const;
+
+        /**
+         * @brief Case-insensitive substring filter over sortedValues()
+         * @details One find() pass over the concatenated lowercase values: hits map back to their value by
+         *          binary search and skip the rest of it, so the cost does not depend on the match count.
+         * @param lowerQuery Non-empty, already lowercase
+         * @param matches Replaced with indices into sortedValues(): prefix matches first, then the
+         *        other matches, each in sorted order
+         */
+        void filter(
+            dnv::vista::sdk::CodebookName codebook, std::string_view lowerQuery, std::vector<uint32_t>& matches ) const;
+
+    private:
+        // Heterogeneous lookup: string_view queries without building a std::string
+        struct StringHash
+        {
+            using is_transparent = void;
+
+            size_t operator()( std::string_view value ) const noexcept
+            {
+                return std::hash<std::string_view>{}( value );
+            }
+        };
+
+        struct Entry
+        {
+            std::vector<std::string> sorted;
+            std::unordered_set<std::string, StringHash, std::equal_to<>> standard; ///< Same values as sorted
+            std::string corpus;            ///< Lowercase sorted values, each followed by '\n'
+            std::vector<uint32_t> offsets; ///< Start of each value in corpus, plus corpus.size()
+        };
+
+        CodebookCache() = default;
+
+        /**
+         * @return Position in k_tagCodebooks, k_tagCodebooks.size() if absent
+         */
+        static size_t slot( dnv::vista::sdk::CodebookName codebook );
+
+        std::array<Entry, k_tagCodebooks.size()> m_entries;
+    };
+} // namespace nfx::vista
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+struct ImDrawData;
+
+namespace nfx::vista
+{
+    /**
+     * @brief Cheap 64-bit fingerprint of a frame's draw data
+     * @details Covers display geometry, vertex/index buffers and draw commands (clip rects,
+     *          textures, offsets). Two frames with the same fingerprint produce the same image.
+     * @return nullopt when the frame must be rendered regardless: user callbacks or pending
+     *         texture uploads
+     */
+    std::optional<uint64_t> hashDrawData( const ImDrawData& drawData, int framebufferWidth, int framebufferHeight );
+} // namespace nfx::vista
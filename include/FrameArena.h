@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace nfx::vista
+{
+    /**
+     * @brief Bump-pointer arena for strings and vectors that live for one frame, main thread only
+     * @details Allocation advances a pointer, deallocation does nothing, reset() at the start of each
+     *          frame rewinds it. When a frame overflows the arena, extra chunks are taken from the heap;
+     *          the next reset() merges them into a single chunk of the combined size, so after a few
+     *          frames the working set fits and the arena stops touching the heap.
+     *
+     *          Anything allocated from the arena must be gone before the next reset(): use the Frame*
+     *          types for locals only, never for members or values handed to another frame or thread.
+     */
+    class FrameArena
+    {
+    public:
+        static std::pmr::memory_resource* resource();
+
+        /**
+         * @brief Start a new frame: everything allocated so far is released
+         */
+        static void reset();
+
+        /**
+         * @brief Bytes handed out since the last reset()
+         */
+        static size_t used();
+
+        /**
+         * @brief Largest used() seen at a reset()
+         */
+        static size_t peak();
+
+        static size_t capacity();
+    };
+
+    using FrameString = std::pmr::string;
+
+    template <typename T>
+    using FrameVector = std::pmr::vector<T>;
+} // namespace nfx::vista
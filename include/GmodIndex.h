@@ -0,0 +1,131 @@
+#pragma once
+
+#include <dnv/vista/sdk/VIS.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace nfx::vista
+{
+    class MappedFile;
+
+    /**
+     * @brief Derived per-version index over a Gmod
+     * @details Precomputes what the Gmod viewer would otherwise rebuild every frame:
+     *          - lowercase search corpus (code, name, common name)
+     *          - display children, with selections and product types flattened as in the tree
+     *          - natural-sorted root children
+     *          - subtree metrics (descendant count, depth)
+     *
+     *          Nodes are addressed by their position in Gmod iteration order. All tables live in one
+     *          relocatable buffer (offsets only), either built in memory or mapped from a snapshot
+     *          file keyed by VIS version and SDK build hash.
+     */
+    class GmodIndex
+    {
+    public:
+        static constexpr uint32_t k_none = 0xFFFFFFFFu;    ///< No node / no badge
+        static constexpr uint32_t k_inherit = 0xFFFFFFFEu; ///< Badge: reuse the badge passed to the parent
+
+        /**
+         * @brief Child as rendered in the tree, with the badge shown in front of it
+         */
+        struct DisplayChild
+        {
+            uint32_t node;
+            uint32_t badge; ///< Node index, k_none or k_inherit
+        };
+
+        ~GmodIndex();
+        GmodIndex( const GmodIndex& ) = delete;
+        GmodIndex& operator=( const GmodIndex& ) = delete;
+
+        static std::unique_ptr<GmodIndex> build(
+            dnv::vista::sdk::VisVersion version, const dnv::vista::sdk::Gmod& gmod );
+
+        /**
+         * @brief Map a snapshot, nullptr if missing, stale or not matching the Gmod
+         * @details A snapshot that loads has its modification time refreshed, see removeStaleSnapshots()
+         */
+        static std::unique_ptr<GmodIndex> loadSnapshot(
+            const std::filesystem::path& path,
+            dnv::vista::sdk::VisVersion version,
+            const dnv::vista::sdk::Gmod& gmod );
+
+        /**
+         * @brief Write the index atomically (temporary file + rename)
+         */
+        bool saveSnapshot( const std::filesystem::path& path ) const;
+
+        /**
+         * @brief Snapshot location for a version under ProjectSerializer::defaultDir()
+         * @return Empty when the SDK build is unknown: snapshots are disabled
+         */
+        static std::filesystem::path snapshotPath( dnv::vista::sdk::VisVersion version );
+
+        /**
+         * @brief Remove snapshots of this version that no SDK build has loaded for 30 days
+         */
+        static void removeStaleSnapshots( dnv::vista::sdk::VisVersion version );
+
+        size_t nodeCount() const
+        {
+            return m_nodes.size();
+        }
+
+        const dnv::vista::sdk::GmodNode& node( uint32_t index ) const
+        {
+            return *m_nodes[index];
+        }
+
+        std::optional<uint32_t> indexOf( std::string_view code ) const;
+
+        uint32_t parent( uint32_t index ) const;
+        uint32_t depth( uint32_t index ) const;
+        uint32_t descendantCount( uint32_t index ) const;
+
+        /**
+         * @brief Structural nodes (individualizable sets 'i', selections 's') are hidden from search
+         */
+        bool isStructural( uint32_t index ) const;
+
+        /**
+         * @brief Lowercase "code\x1fname\x1fcommon name" used for substring search
+         */
+        std::string_view searchText( uint32_t index ) const;
+
+        std::span<const DisplayChild> displayChildren( uint32_t index ) const;
+        std::span<const uint32_t> rootChildren() const;
+
+        /**
+         * @brief Size of the index tables (mapped or owned) plus the resolved node table
+         */
+        size_t byteSize() const;
+
+        bool isMapped() const
+        {
+            return m_mapping != nullptr;
+        }
+
+    private:
+        struct Header;
+        struct NodeRecord;
+
+        GmodIndex() = default;
+
+        const Header& header() const;
+        const NodeRecord& record( uint32_t index ) const;
+        bool resolveNodes( const dnv::vista::sdk::Gmod& gmod );
+
+        std::vector<std::byte> m_buffer;       ///< Owned tables when built in memory
+        std::unique_ptr<MappedFile> m_mapping; ///< Mapped tables when loaded from a snapshot
+        const std::byte* m_data = nullptr;
+        std::vector<const dnv::vista::sdk::GmodNode*> m_nodes;
+    };
+} // namespace nfx::vista
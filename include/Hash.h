@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace nfx::vista::hash
+{
+    /**
+     * @brief Fast non-cryptographic 64-bit hashing for change detection (fingerprints), not for hash tables
+     * @details Chain the calls: h = hash::string( hash::mix( hash::k_seed, x ), text ).
+     */
+    constexpr uint64_t k_seed = 0xcbf29ce484222325ull;
+    constexpr uint64_t k_multiplier = 0x9e3779b97f4a7c15ull;
+
+    inline uint64_t mix( uint64_t h, uint64_t value )
+    {
+        h ^= value;
+        h *= k_multiplier;
+        h ^= h >> 29;
+        return h;
+    }
+
+    // Word at a time: draw data fingerprints hash whole vertex buffers every frame
+    inline uint64_t bytes( uint64_t h, const void* data, size_t size )
+    {
+        const auto* p = static_cast<const unsigned char*>( data );
+
+        size_t i = 0;
+        for( ; i + sizeof( uint64_t ) <= size; i += sizeof( uint64_t ) )
+        {
+            uint64_t word;
+            std::memcpy( &word, p + i, sizeof( word ) );
+            h = mix( h, word );
+        }
+
+        uint64_t tail = 0;
+        if( size > i )
+        {
+            std::memcpy( &tail, p + i, size - i );
+        }
+        return mix( h, tail ^ static_cast<uint64_t>( size ) );
+    }
+
+    /**
+     * @brief Length is included: consecutive strings cannot run into each other
+     */
+    inline uint64_t string( uint64_t h, std::string_view text )
+    {
+        return bytes( h, text.data(), text.size() );
+    }
+
+    template <typename T>
+    uint64_t value( uint64_t h, const T& v )
+    {
+        return bytes( h, &v, sizeof( v ) );
+    }
+} // namespace nfx::vista::hash
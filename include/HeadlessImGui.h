@@ -0,0 +1,26 @@
+#pragma once
+
+#include <imgui.h>
+
+namespace nfx::vista
+{
+    /**
+     * @brief ImGui context without platform or renderer backend
+     * @details Fixed display size and time step so runs are deterministic. Draw data is built
+     *          but never submitted; texture requests are acknowledged without uploading.
+     */
+    class HeadlessImGui
+    {
+    public:
+        explicit HeadlessImGui( ImVec2 displaySize );
+        ~HeadlessImGui();
+        HeadlessImGui( const HeadlessImGui& ) = delete;
+        HeadlessImGui& operator=( const HeadlessImGui& ) = delete;
+
+        void newFrame();
+        void render();
+
+    private:
+        ImGuiContext* m_context = nullptr;
+    };
+} // namespace nfx::vista
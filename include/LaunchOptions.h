@@ -0,0 +1,38 @@
+#pragma once
+
+#include "RenderingMode.h"
+
+#include <cstddef>
+#include <optional>
+#include <string>
+
+namespace nfx::vista
+{
+    /**
+     * @brief Command line options
+     */
+    struct LaunchOptions
+    {
+        static constexpr size_t k_defaultMemoryBudgetMb = 64;
+
+        size_t memoryBudgetBytes = k_defaultMemoryBudgetMb * 1024 * 1024; ///< Derived VIS data, 0 = unlimited
+        RenderingMode::Mode renderingMode = RenderingMode::Mode::EventDriven;
+        int targetFps = RenderingMode::k_defaultTargetFps; ///< Budgeted mode frame cap
+        bool startupReport = false;    ///< Print the startup timing JSON once all versions are loaded
+        std::string startupReportPath; ///< Write it to this file instead of stdout
+        bool quitAfterStartup = false; ///< Close the window after the startup report
+        std::string recordInputPath;   ///< Record every frame's input to this file
+        std::string replayInputPath;   ///< Drive the UI from a recording instead of live input, then exit
+        std::string replayReportPath;  ///< Write the replay timing JSON here instead of stdout
+        bool headless = false;         ///< Replay without a window or OpenGL context
+        std::string tracePath;         ///< Trace scopes from launch and write trace-event JSON here on exit
+        bool showHelp = false;
+
+        /**
+         * @brief Parse argv, nullopt (after printing the reason) on invalid arguments
+         */
+        static std::optional<LaunchOptions> parse( int argc, char** argv );
+
+        static void printUsage( const char* program );
+    };
+} // namespace nfx::vista
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <dnv/vista/sdk/VIS.h>
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace nfx::vista
+{
+    class CodebookCache;
+
+    /**
+     * @brief Metadata tag values of a LocalId, empty when absent
+     */
+    struct MetadataTags
+    {
+        std::string quantity;
+        std::string content;
+        std::string position;
+        std::string calculation;
+        std::string state;
+        std::string command;
+        std::string type;
+        std::string detail;
+    };
+
+    /**
+     * @brief Everything a LocalId string is composed from
+     */
+    struct LocalIdParts
+    {
+        dnv::vista::sdk::VisVersion version;
+        std::string_view primaryText;                         ///< Written as-is when primary is not parsed
+        const dnv::vista::sdk::GmodPath* primary = nullptr;   ///< Parsed primaryText, if valid
+        std::string_view secondaryText;                       ///< Empty: no secondary item
+        const dnv::vista::sdk::GmodPath* secondary = nullptr; ///< Parsed secondaryText, if valid
+        bool verbose = false;
+        const MetadataTags* tags = nullptr;
+    };
+
+    /**
+     * @brief Compose the LocalId string shown by the builder, shared by batch generation and the CLI
+     * @details When every given path is parsed the item part comes from the SDK's LocalIdBuilder (verbose
+     *          mode needs it); otherwise the texts are written as typed, so the user sees what the validator
+     *          rejects. Tags follow /meta with '-' for standard values and '~' for custom ones; Detail is
+     *          always '-'. Without a primary path there is no metadata section.
+     * @param codebooks Standard values of parts.version, nullptr writes every tag as standard
+     */
+    void composeLocalId( const LocalIdParts& parts, const CodebookCache* codebooks, std::string& out );
+
+    /**
+     * @brief Short path with the location on the node of the first individualizable set
+     * @return Nothing when the path has no individualizable set to take the location
+     */
+    std::optional<std::string> applyLocation( const dnv::vista::sdk::GmodPath& path, std::string_view location );
+
+    /**
+     * @brief Call f( line, lineNumber ) for each non-blank line of text, without copying
+     * @details Lines end at '\n', surrounding whitespace (including the '\r' of CRLF) is trimmed and
+     *          the views point into text. Line numbers are 1-based and count blank lines.
+     */
+    template <typename F>
+    void forEachLine( std::string_view text, F&& f )
+    {
+        constexpr std::string_view whitespace = " \t\r\v\f";
+
+        size_t lineNumber = 0;
+        size_t pos = 0;
+        while( pos < text.size() )
+        {
+            size_t end = text.find( '\n', pos );
+            if( end == std::string_view::npos )
+            {
+                end = text.size();
+            }
+            ++lineNumber;
+
+            std::string_view line = text.substr( pos, end - pos );
+            const size_t first = line.find_first_not_of( whitespace );
+            if( first != std::string_view::npos )
+            {
+                line = line.substr( first, line.find_last_not_of( whitespace ) - first + 1 );
+                f( line, lineNumber );
+            }
+            pos = end + 1;
+        }
+    }
+} // namespace nfx::vista
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+
+namespace nfx::vista
+{
+    /**
+     * @brief Read-only memory mapping of a whole file
+     */
+    class MappedFile
+    {
+    public:
+        ~MappedFile();
+        MappedFile( const MappedFile& ) = delete;
+        MappedFile& operator=( const MappedFile& ) = delete;
+
+        /**
+         * @brief Map a file read-only, nullptr if it does not exist or cannot be mapped
+         */
+        static std::unique_ptr<MappedFile> open( const std::filesystem::path& path );
+
+        const std::byte* data() const
+        {
+            return m_data;
+        }
+
+        size_t size() const
+        {
+            return m_size;
+        }
+
+    private:
+        MappedFile() = default;
+
+        const std::byte* m_data = nullptr;
+        size_t m_size = 0;
+#if defined( _WIN32 )
+        void* m_file = nullptr;
+        void* m_mapping = nullptr;
+#endif
+    };
+} // namespace nfx::vista
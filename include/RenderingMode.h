@@ -2,15 +2,22 @@
 
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+
 namespace nfx
 {
     /**
      * @brief Rendering mode abstraction for GLFW event handling
-     * @details Supports three modes:
+     * @details Supports four modes:
      *          - EventDriven: glfwWaitEvents() - waits indefinitely for events, ~0% GPU at rest
      *          - Adaptive:    glfwWaitEventsTimeout() - wakes on events or after a timeout,
      *                         balances responsiveness and GPU usage
      *          - Polling:     glfwPollEvents() - continuous polling, highest CPU/GPU usage
+     *          - Budgeted:    capped at a target frame rate while the user interacts, decays to
+     *                         slow wake-ups when idle and to event-driven when in the background
      */
     class RenderingMode
     {
@@ -19,9 +26,23 @@ namespace nfx
         {
             Adaptive,    ///< Adaptive: wake on events or timeout, low GPU at rest (glfwWaitEventsTimeout)
             EventDriven, ///< Event-driven: wait indefinitely for events (glfwWaitEvents)
-            Polling      ///< Polling: continuous polling (glfwPollEvents)
+            Polling,     ///< Polling: continuous polling (glfwPollEvents)
+            Budgeted     ///< Budgeted: target frame rate after input, event-driven when unfocused/minimized
         };
 
+        /**
+         * @brief Measured frame pacing (exponential moving averages)
+         */
+        struct Pacing
+        {
+            double intervalMs = 0.0; ///< Time between frame starts
+            double jitterMs = 0.0;   ///< Mean deviation from intervalMs
+            bool boosting = false;   ///< Running at the target rate after recent input
+            bool background = false; ///< Unfocused, minimized or zero-sized: event-driven
+        };
+
+        static constexpr int k_defaultTargetFps = 60;
+
         explicit RenderingMode( Mode mode = Mode::EventDriven )
             : m_mode{ mode }
         {
@@ -32,7 +53,7 @@ namespace nfx
          */
         Mode mode() const
         {
-            return m_mode;
+            return m_mode.load( std::memory_order_relaxed );
         }
 
         /**
@@ -40,22 +61,96 @@ namespace nfx
          */
         void setMode( Mode mode )
         {
-            m_mode = mode;
+            m_mode.store( mode, std::memory_order_relaxed );
+        }
+
+        /**
+         * @brief Window whose focus/iconify state drives Budgeted mode
+         */
+        void setWindow( GLFWwindow* window )
+        {
+            m_window = window;
+        }
+
+        int targetFps() const
+        {
+            return m_targetFps;
+        }
+
+        void setTargetFps( int fps )
+        {
+            m_targetFps = std::clamp( fps, k_minTargetFps, k_maxTargetFps );
+        }
+
+        /**
+         * @brief Seconds on a monotonic clock; unlike glfwGetTime() it needs no glfwInit (headless replay)
+         */
+        static double now()
+        {
+            return std::chrono::duration<double>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+        }
+
+        /**
+         * @brief Call at the start of every frame, measures pacing
+         */
+        void frameStarted()
+        {
+            const double time = now();
+            if( m_lastFrameStart > 0.0 )
+            {
+                const double intervalMs = ( time - m_lastFrameStart ) * 1000.0;
+                if( m_pacing.intervalMs == 0.0 )
+                {
+                    m_pacing.intervalMs = intervalMs;
+                }
+                m_pacing.jitterMs +=
+                    k_pacingSmoothing * ( std::abs( intervalMs - m_pacing.intervalMs ) - m_pacing.jitterMs );
+                m_pacing.intervalMs += k_pacingSmoothing * ( intervalMs - m_pacing.intervalMs );
+            }
+            m_lastFrameStart = time;
+
+            if( m_wakeTime != 0.0 && time >= m_wakeTime )
+            {
+                m_wakeTime = 0.0;
+            }
+        }
+
+        /**
+         * @brief Call when the frame received user input, boosts Budgeted mode
+         */
+        void notifyInput()
+        {
+            m_lastInputTime = now();
+        }
+
+        const Pacing& pacing() const
+        {
+            return m_pacing;
         }
 
         /**
          * @brief Wait for or poll events based on current mode
-         * @details Call this in the main loop
+         * @details Call this in the main loop. When the frame was not presented (identical to the
+         *          previous one) there was no vsync wait, so Polling waits one refresh interval instead
+         *          of spinning.
          */
-        void waitOrPollEvents() const
+        void waitOrPollEvents( bool framePresented = true )
         {
-            if( m_mode == Mode::EventDriven )
+            if( mode() == Mode::EventDriven )
             {
-                glfwWaitEvents();
+                waitEvents( k_noTimeout );
+            }
+            else if( mode() == Mode::Adaptive )
+            {
+                waitEvents( k_adaptiveTimeoutSeconds );
+            }
+            else if( mode() == Mode::Budgeted )
+            {
+                waitBudgeted();
             }
-            else if( m_mode == Mode::Adaptive )
+            else if( !framePresented )
             {
-                glfwWaitEventsTimeout( k_adaptiveTimeoutSeconds );
+                glfwWaitEventsTimeout( k_skippedFrameTimeoutSeconds );
             }
             else
             {
@@ -65,23 +160,62 @@ namespace nfx
 
         /**
          * @brief Notify that a change occurred and rendering is needed
-         * @details In EventDriven mode, posts an empty event to wake up glfwWaitEvents()
-         *          In Polling mode, does nothing (already polling continuously)
+         * @details In EventDriven and Budgeted modes, posts an empty event to wake up the wait
+         *          In Polling and Adaptive modes, does nothing (woken up regularly anyway)
+         *          Safe to call from worker threads publishing results.
          */
         void notifyChange() const
         {
-            if( m_mode == Mode::EventDriven )
+            const Mode current = mode();
+            if( current == Mode::EventDriven || current == Mode::Budgeted )
+            {
+                wake();
+            }
+        }
+
+        /**
+         * @brief Wake the event wait in every mode, safe to call from worker threads
+         * @details Does nothing until setEventsReady(): workers started before glfwInit (and all of them
+         *          in headless replay, where GLFW is never initialized) must not call into GLFW.
+         */
+        void wake() const
+        {
+            if( m_eventsReady.load( std::memory_order_acquire ) )
             {
                 glfwPostEmptyEvent();
             }
         }
 
+        /**
+         * @brief Main thread, once GLFW is initialized: events may be posted from now on
+         * @details Posts one event for the wake-ups dropped before, so their results are not left unseen.
+         */
+        void setEventsReady()
+        {
+            m_eventsReady.store( true, std::memory_order_release );
+            glfwPostEmptyEvent();
+        }
+
+        /**
+         * @brief Main thread: make sure a frame starts within the delay, even without events
+         * @details For work scheduled on time rather than on input, e.g. a debounced parse once typing pauses.
+         *          Only the earliest pending wake-up is kept; it is consumed by the frame that reaches it.
+         */
+        void wakeAfter( double seconds )
+        {
+            const double time = now() + seconds;
+            if( m_wakeTime == 0.0 || time < m_wakeTime )
+            {
+                m_wakeTime = time;
+            }
+        }
+
         /**
          * @brief Get mode name as string
          */
         const char* modeName() const
         {
-            switch( m_mode )
+            switch( mode() )
             {
                 case Mode::Adaptive:
                     return "Adaptive";
@@ -89,12 +223,100 @@ namespace nfx
                     return "Event-driven";
                 case Mode::Polling:
                     return "Polling";
+                case Mode::Budgeted:
+                    return "Budgeted";
             }
             return "";
         }
 
     private:
-        static constexpr double k_adaptiveTimeoutSeconds = 0.2; ///< Max wait in Adaptive mode
-        Mode m_mode;
+        bool isBackground() const
+        {
+            if( !m_window )
+            {
+                return false;
+            }
+
+            // GLFW has no occlusion query: minimized, hidden or zero-sized stands in for it
+            int width = 0;
+            int height = 0;
+            glfwGetFramebufferSize( m_window, &width, &height );
+            return !glfwGetWindowAttrib( m_window, GLFW_FOCUSED ) || glfwGetWindowAttrib( m_window, GLFW_ICONIFIED ) ||
+                   !glfwGetWindowAttrib( m_window, GLFW_VISIBLE ) || width == 0 || height == 0;
+        }
+
+        /**
+         * @brief Wait for events, at most the timeout (k_noTimeout: none) and never past a wakeAfter()
+         */
+        void waitEvents( double timeoutSeconds )
+        {
+            if( m_wakeTime != 0.0 )
+            {
+                const double remaining = m_wakeTime - now();
+                if( remaining <= 0.0 )
+                {
+                    glfwPollEvents();
+                    return;
+                }
+                timeoutSeconds = timeoutSeconds < 0.0 ? remaining : std::min( timeoutSeconds, remaining );
+            }
+
+            if( timeoutSeconds < 0.0 )
+            {
+                glfwWaitEvents();
+            }
+            else
+            {
+                glfwWaitEventsTimeout( timeoutSeconds );
+            }
+        }
+
+        void waitBudgeted()
+        {
+            m_pacing.background = isBackground();
+            m_pacing.boosting = !m_pacing.background && now() - m_lastInputTime < k_boostSeconds;
+
+            if( m_pacing.background )
+            {
+                // Nothing to animate for the user: sleep until something happens
+                waitEvents( k_noTimeout );
+                return;
+            }
+
+            if( m_pacing.boosting )
+            {
+                glfwPollEvents();
+            }
+            else
+            {
+                // Foreground but idle: wake on events, or slowly for time-based widgets (cursor blink, progress)
+                waitEvents( k_budgetedIdleTimeoutSeconds );
+            }
+
+            // Frame cap: do not start the next frame before its slot, events keep being queued meanwhile
+            const double deadline = m_lastFrameStart + 1.0 / m_targetFps;
+            for( double time = now(); time < deadline; time = now() )
+            {
+                glfwWaitEventsTimeout( deadline - time );
+            }
+        }
+
+        static constexpr double k_noTimeout = -1.0;                        ///< waitEvents(): until an event
+        static constexpr double k_adaptiveTimeoutSeconds = 0.2;            ///< Max wait in Adaptive mode
+        static constexpr double k_skippedFrameTimeoutSeconds = 1.0 / 60.0; ///< Polling wait after a skipped frame
+        static constexpr double k_budgetedIdleTimeoutSeconds = 0.5;        ///< Budgeted wait when idle in foreground
+        static constexpr double k_boostSeconds = 1.0;                      ///< Budgeted: full rate after input
+        static constexpr double k_pacingSmoothing = 0.1;                   ///< EMA factor of the pacing metrics
+        static constexpr int k_minTargetFps = 5;
+        static constexpr int k_maxTargetFps = 240;
+
+        std::atomic<Mode> m_mode;                 ///< Read by notifyChange() on worker threads
+        std::atomic<bool> m_eventsReady{ false }; ///< GLFW initialized, read by wake() on worker threads
+        GLFWwindow* m_window = nullptr;
+        int m_targetFps = k_defaultTargetFps;
+        double m_lastFrameStart = 0.0;
+        double m_lastInputTime = 0.0;
+        double m_wakeTime = 0.0; ///< now() of the pending wakeAfter(), 0 if none
+        Pacing m_pacing;
     };
 } // namespace nfx
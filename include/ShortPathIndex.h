@@ -0,0 +1,68 @@
+#pragma once
+
+#include <dnv/vista/sdk/VIS.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace nfx::vista
+{
+    class GmodIndex;
+
+    /**
+     * @brief Derived per-version table of the segments that may follow a short path segment
+     * @details A short path lists the leaf nodes of a full path plus its target node, so the segment
+     *          after a leaf (or the first segment, after the root) is any node reachable through
+     *          non-leaf nodes only. Those transitions are flattened per origin at load time and sorted
+     *          by code, so completing a typed prefix is a binary search instead of trial parsing.
+     *
+     *          Nodes are GmodIndex positions; queries take the GmodIndex the table was built from.
+     */
+    class ShortPathIndex
+    {
+    public:
+        ShortPathIndex( const ShortPathIndex& ) = delete;
+        ShortPathIndex& operator=( const ShortPathIndex& ) = delete;
+
+        static std::unique_ptr<const ShortPathIndex> build(
+            const dnv::vista::sdk::Gmod& gmod, const GmodIndex& index );
+
+        /**
+         * @brief Origin of the first segment of a path
+         */
+        uint32_t root() const
+        {
+            return m_root;
+        }
+
+        /**
+         * @brief Nodes that may follow origin in a short path, sorted by case-folded code; empty for non-leaf nodes,
+         *        which can only end a path
+         */
+        std::span<const uint32_t> next( uint32_t origin ) const;
+
+        /**
+         * @brief The part of next( origin ) whose codes start with the prefix, case-insensitive
+         */
+        std::span<const uint32_t> next( const GmodIndex& index, uint32_t origin, std::string_view codePrefix ) const;
+
+        size_t byteSize() const;
+
+    private:
+        struct Range
+        {
+            uint32_t offset = 0;
+            uint32_t count = 0;
+        };
+
+        ShortPathIndex() = default;
+
+        uint32_t m_root = 0;
+        std::vector<Range> m_ranges; ///< Per node
+        std::vector<uint32_t> m_pool;
+    };
+} // namespace nfx::vista
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nfx::vista
+{
+    /**
+     * @brief Fixed-size worker pool used for background loading and indexing
+     * @details Tasks are executed in submission order by the first idle worker, interactive tasks
+     *          (results the UI is waiting for) before background ones (loading, indexing).
+     *          Pending tasks are discarded on destruction; running tasks are joined.
+     */
+    class ThreadPool
+    {
+    public:
+        enum class Priority
+        {
+            Background,
+            Interactive
+        };
+
+        /**
+         * @param threadCount Number of workers, 0 = one per hardware thread
+         */
+        explicit ThreadPool( size_t threadCount = 0 );
+        ~ThreadPool();
+        ThreadPool( const ThreadPool& ) = delete;
+        ThreadPool& operator=( const ThreadPool& ) = delete;
+
+        /**
+         * @brief Queue a task for execution on a worker thread
+         */
+        void submit( std::function<void()> task, Priority priority = Priority::Background );
+
+        /**
+         * @brief Run body( begin, end ) over [0, count) in chunks of chunkSize, one task per chunk
+         * @details Returns at once. done() runs on the worker that finishes the last chunk (right away on a
+         *          worker when count is 0), so a caller can publish the whole result without waiting.
+         */
+        void parallelFor(
+            size_t count,
+            size_t chunkSize,
+            std::function<void( size_t begin, size_t end )> body,
+            std::function<void()> done,
+            Priority priority = Priority::Background );
+
+        /**
+         * @brief Block until no task is queued or running, including tasks submitted meanwhile
+         */
+        void waitIdle();
+
+        size_t threadCount() const
+        {
+            return m_workers.size();
+        }
+
+    private:
+        void workerLoop();
+
+        std::vector<std::thread> m_workers;
+        std::deque<std::function<void()>> m_tasks;
+        std::deque<std::function<void()>> m_interactiveTasks;
+        std::mutex m_mutex;
+        std::condition_variable m_wakeup;
+        std::condition_variable m_idle;
+        size_t m_running = 0;
+        bool m_stopping = false;
+    };
+} // namespace nfx::vista
@@ -0,0 +1,234 @@
+#pragma once
+
+#include "CodebookCache.h"
+#include "GmodIndex.h"
+#include "ShortPathIndex.h"
+
+#include <dnv/vista/sdk/VIS.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace nfx::vista
+{
+    class ThreadPool;
+
+    /**
+     * @brief Per-version VIS data, loaded in the background
+     * @details Each VIS version is loaded (Gmod, Codebooks, Locations, GmodIndex) by a task on the thread pool.
+     *          The main thread never touches a version's data until it is published as Ready,
+     *          so the UI stays interactive while older versions are still being decompressed.
+     *
+     *          Derived data is kept under a memory budget: trim() evicts the least recently used
+     *          versions and use() reloads them on demand. The Gmod, Codebooks and Locations objects
+     *          are owned by the SDK's VIS cache for the whole process and are not counted; neither is
+     *          the small CodebookCache, which stays resident so every version's tags are ready.
+     *
+     *          Versions load on several workers at once. The SDK's VIS cache is thread-safe: concurrent
+     *          VIS::gmod, codebooks and locations calls fill each version once and share it, which this
+     *          store and every worker that parses paths or LocalIds rely on.
+     */
+    class VersionStore
+    {
+    public:
+        enum class State
+        {
+            Pending, ///< Not yet picked up by a worker
+            Loading, ///< A worker is loading the version
+            Ready,   ///< Data is available through find()
+            Failed,  ///< Loading threw, see the log
+            Evicted  ///< Derived data dropped by trim(), reloaded by the next use()
+        };
+
+        /**
+         * @brief Where the last load of a version spent its time
+         */
+        struct LoadTimings
+        {
+            std::chrono::steady_clock::time_point start;
+            std::chrono::steady_clock::time_point end;
+            double gmodSeconds = 0.0; ///< Resource decompression and Gmod construction (inside the SDK)
+            double codebooksSeconds = 0.0; ///< Including the CodebookCache
+            double locationsSeconds = 0.0;
+            double indexSeconds = 0.0; ///< GmodIndex snapshot mapping or rebuild, ShortPathIndex build
+
+            double totalSeconds() const
+            {
+                return std::chrono::duration<double>( end - start ).count();
+            }
+        };
+
+        /**
+         * @brief Loaded data for one VIS version
+         */
+        struct Entry
+        {
+            dnv::vista::sdk::VisVersion version;
+            const dnv::vista::sdk::Gmod* gmod = nullptr;
+            const dnv::vista::sdk::Codebooks* codebooks = nullptr;
+            const dnv::vista::sdk::Locations* locations = nullptr;
+            std::shared_ptr<const CodebookCache> codebookCache; ///< Built once, never evicted
+            std::shared_ptr<const GmodIndex> index; ///< Shared with worker tasks reading it across an eviction
+            std::shared_ptr<const ShortPathIndex> shortPaths; ///< Over index, evicted with it
+            bool indexFromSnapshot = false;
+            size_t nodeCount = 0;
+            LoadTimings timings;
+
+            /**
+             * @brief Approximate bytes held by the evictable (derived) data
+             */
+            size_t residentBytes() const
+            {
+                return ( index ? index->byteSize() : 0 ) + ( shortPaths ? shortPaths->byteSize() : 0 );
+            }
+        };
+
+        /**
+         * @brief Residency counters, see use() and trim()
+         */
+        struct Residency
+        {
+            size_t residentBytes = 0;
+            size_t residentVersions = 0;
+            size_t hits = 0;      ///< Switched to a version that was resident
+            size_t misses = 0;    ///< Switched to a version that had to be (re)loaded
+            size_t evictions = 0; ///< Versions dropped to stay under the budget
+        };
+
+        VersionStore( const dnv::vista::sdk::VIS& vis, ThreadPool& pool );
+        VersionStore( const VersionStore& ) = delete;
+        VersionStore& operator=( const VersionStore& ) = delete;
+
+        /**
+         * @brief Queue all versions for loading, newest first
+         */
+        void preloadAll();
+
+        /**
+         * @brief Get the data of a version, nullptr until it is Ready
+         */
+        const Entry* find( dnv::vista::sdk::VisVersion version ) const;
+
+        /**
+         * @brief Main thread: get a version for display and mark it most recently used
+         * @details Switching to an evicted version counts a miss and queues its reload;
+         *          returns nullptr until it is Ready again.
+         */
+        const Entry* use( dnv::vista::sdk::VisVersion version );
+
+        /**
+         * @brief Main thread: start loading a version that is not resident, without counting a use
+         * @details Skipped when another version would not fit in the budget, so speculative loads
+         *          never push out data that is in use.
+         * @return true if a load was queued
+         */
+        bool prefetch( dnv::vista::sdk::VisVersion version );
+
+        /**
+         * @brief Versions passed to use(), most recent first
+         */
+        std::vector<dnv::vista::sdk::VisVersion> recentlyUsed( size_t count ) const;
+
+        /**
+         * @brief Main thread: evict least recently used versions until under the budget
+         * @details The most recently used version is never evicted. Call between frames.
+         */
+        void trim();
+
+        /**
+         * @brief Budget for derived data in bytes, 0 disables eviction
+         */
+        void setMemoryBudget( size_t bytes )
+        {
+            m_budget = bytes;
+        }
+
+        size_t memoryBudget() const
+        {
+            return m_budget;
+        }
+
+        Residency residency() const;
+
+        State state( dnv::vista::sdk::VisVersion version ) const;
+
+        /**
+         * @brief Timings of the last load, nullopt while the version is not Ready or Failed
+         */
+        std::optional<LoadTimings> loadTimings( dnv::vista::sdk::VisVersion version ) const;
+
+        std::vector<dnv::vista::sdk::VisVersion> versions() const;
+
+        bool isReady( dnv::vista::sdk::VisVersion version ) const
+        {
+            return state( version ) == State::Ready;
+        }
+
+        size_t versionCount() const
+        {
+            return m_slots.size();
+        }
+
+        /**
+         * @brief Number of versions that finished loading (Ready or Failed)
+         */
+        size_t settledCount() const
+        {
+            return m_settled.load( std::memory_order_acquire );
+        }
+
+        bool isLoading() const
+        {
+            return settledCount() < versionCount();
+        }
+
+        /**
+         * @brief Any version queued or being loaded, including reloads after eviction
+         */
+        bool hasPendingLoads() const;
+
+        /**
+         * @brief Called from a worker thread whenever a version settles
+         */
+        void setChangeNotifier( std::function<void()> notifier )
+        {
+            m_onChanged = std::move( notifier );
+        }
+
+    private:
+        struct Slot
+        {
+            Entry entry;
+            std::atomic<State> state{ State::Pending };
+            bool settledOnce = false; ///< Written by the loading worker only
+            uint64_t lastUse = 0;     ///< Main thread only
+        };
+
+        Slot* slot( dnv::vista::sdk::VisVersion version ) const;
+        void load( Slot& slot );
+        void evict( Slot& slot );
+        void queueReload( Slot& slot );
+        static std::unique_ptr<const GmodIndex> loadIndex( Entry& entry );
+
+        const dnv::vista::sdk::VIS& m_vis;
+        ThreadPool& m_pool;
+        std::function<void()> m_onChanged;
+
+        std::vector<std::unique_ptr<Slot>> m_slots;
+        std::atomic<size_t> m_settled{ 0 };
+
+        // Residency, main thread only
+        size_t m_budget = 0;
+        uint64_t m_useClock = 0;
+        std::optional<dnv::vista::sdk::VisVersion> m_active;
+        size_t m_hits = 0;
+        size_t m_misses = 0;
+        size_t m_evictions = 0;
+    };
+} // namespace nfx::vista
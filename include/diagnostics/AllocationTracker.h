@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace nfx::vista
+{
+    /**
+     * @brief Subsystem an allocation is attributed to
+     */
+    enum class AllocationTag : uint8_t
+    {
+        Other,            ///< Outside any tagged scope
+        GmodViewer,       ///< Gmod tree, search and overlay
+        NodeDetails,      ///< Node details panel
+        LocalIdBuilder,   ///< LocalId builder panel
+        LocalIdInspector, ///< LocalId inspector panel and its jobs
+        ProjectManager,   ///< Project manager panel and its file browser
+        Sdk,              ///< Inside Vista SDK calls (parsing, building, VIS loading)
+        ImGui,            ///< ImGui's own heap, through its allocator hooks
+        Count
+    };
+
+    struct AllocationStats
+    {
+        uint64_t count = 0;
+        uint64_t bytes = 0;
+
+        AllocationStats operator-( const AllocationStats& other ) const
+        {
+            return { count - other.count, bytes - other.bytes };
+        }
+
+        AllocationStats& operator+=( const AllocationStats& other )
+        {
+            count += other.count;
+            bytes += other.bytes;
+            return *this;
+        }
+    };
+
+    /**
+     * @brief Heap allocation accounting, per thread and per subsystem tag
+     * @details The global operator new/delete replacements in AllocationHooks.cpp (core library only)
+     *          count every allocation in the calling thread's slot under the innermost active Scope tag;
+     *          without them, as in the command line tool, scopes cost a thread-local store and nothing
+     *          is counted. Slots are claimed without allocating
+     *          and kept after their thread exits, so process totals include finished workers.
+     *          ImGui allocates through malloc unless imguiAlloc/imguiFree are installed with
+     *          ImGui::SetAllocatorFunctions before the context is created.
+     */
+    class AllocationTracker
+    {
+    public:
+        static constexpr size_t k_tagCount = static_cast<size_t>( AllocationTag::Count );
+
+        using Snapshot = std::array<AllocationStats, k_tagCount>;
+
+        /**
+         * @brief Attributes the calling thread's allocations to a tag for its lifetime
+         */
+        class Scope
+        {
+        public:
+            explicit Scope( AllocationTag tag );
+            ~Scope();
+
+            Scope( const Scope& ) = delete;
+            Scope& operator=( const Scope& ) = delete;
+
+        private:
+            AllocationTag m_previous;
+        };
+
+        static Scope scope( AllocationTag tag )
+        {
+            return Scope{ tag };
+        }
+
+        /**
+         * @brief Allocations made so far by the calling thread, per tag
+         */
+        static Snapshot thread();
+
+        /**
+         * @brief Allocations made so far by all threads, per tag
+         */
+        static Snapshot process();
+
+        /**
+         * @brief Count one allocation of the calling thread under its current tag
+         */
+        static void record( size_t size );
+
+        static AllocationStats total( const Snapshot& snapshot );
+
+        static const char* name( AllocationTag tag );
+
+        static void* imguiAlloc( size_t size, void* userData );
+        static void imguiFree( void* ptr, void* userData );
+    };
+} // namespace nfx::vista
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+namespace nfx::vista
+{
+    /**
+     * @brief CPU time per frame section, kept in fixed-size ring buffers
+     * @details Main thread only. Scopes accumulate into the current frame; endFrame() pushes one
+     *          sample per section that ran, so hidden panels do not dilute the percentiles.
+     */
+    class FrameProfiler
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr size_t k_historySize = 512; ///< Frames kept per section
+
+        enum class Section
+        {
+            NewFrame,         ///< Backend and ImGui NewFrame
+            GmodViewer,       ///< GmodViewer::render
+            SearchOverlay,    ///< GmodViewer search results overlay
+            NodeDetails,      ///< NodeDetails::render
+            LocalIdBuilder,   ///< LocalIdBuilder::render
+            LocalIdInspector, ///< LocalIdInspector::render
+            ProjectManager,   ///< ProjectManager::render
+            Submit,           ///< ImGui::Render and GL draw submission
+            Present,          ///< Buffer swap (includes vsync wait)
+            Frame,            ///< Whole frame, NewFrame to Present
+            Count
+        };
+
+        /**
+         * @brief Ring of samples in milliseconds, oldest at next when full
+         */
+        struct History
+        {
+            std::array<float, k_historySize> values{};
+            size_t count = 0;
+            size_t next = 0;
+        };
+
+        struct Stats
+        {
+            float last = 0.f;
+            float p50 = 0.f;
+            float p95 = 0.f;
+            float p99 = 0.f;
+            float max = 0.f;
+            size_t samples = 0;
+        };
+
+        /**
+         * @brief Adds the elapsed time of its lifetime to a section
+         */
+        class Scope
+        {
+        public:
+            Scope( FrameProfiler& profiler, Section section )
+                : m_profiler{ profiler },
+                  m_section{ section },
+                  m_start{ Clock::now() }
+            {
+            }
+
+            ~Scope()
+            {
+                m_profiler.add( m_section, Clock::now() - m_start );
+            }
+
+            Scope( const Scope& ) = delete;
+            Scope& operator=( const Scope& ) = delete;
+
+        private:
+            FrameProfiler& m_profiler;
+            Section m_section;
+            Clock::time_point m_start;
+        };
+
+        Scope scope( Section section )
+        {
+            return Scope{ *this, section };
+        }
+
+        void add( Section section, Clock::duration elapsed );
+
+        /**
+         * @brief Push this frame's accumulated times into the histories
+         * @param presented false when the frame was identical to the previous one and not submitted
+         */
+        void endFrame( bool presented );
+
+        size_t presentedFrames() const
+        {
+            return m_presentedFrames;
+        }
+
+        size_t skippedFrames() const
+        {
+            return m_skippedFrames;
+        }
+
+        const History& history( Section section ) const
+        {
+            return m_histories[index( section )];
+        }
+
+        /**
+         * @brief Most recent sample of a section, 0 before its first frame
+         */
+        float latest( Section section ) const
+        {
+            const History& h = history( section );
+            return h.count > 0 ? h.values[( h.next + k_historySize - 1 ) % k_historySize] : 0.f;
+        }
+
+        /**
+         * @brief Percentiles over the history (sorts a copy, call only when displayed)
+         */
+        Stats stats( Section section ) const;
+
+        static const char* name( Section section );
+
+    private:
+        static constexpr size_t k_sectionCount = static_cast<size_t>( Section::Count );
+
+        static size_t index( Section section )
+        {
+            return static_cast<size_t>( section );
+        }
+
+        std::array<History, k_sectionCount> m_histories{};
+        std::array<Clock::duration, k_sectionCount> m_current{};
+        std::array<bool, k_sectionCount> m_ran{};
+        size_t m_presentedFrames = 0;
+        size_t m_skippedFrames = 0;
+    };
+} // namespace nfx::vista
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nfx::vista
+{
+    /**
+     * @brief Captures the ImGui input of every frame into a compact binary log
+     * @details Call recordFrame() after the platform backend's NewFrame and before ImGui::NewFrame:
+     *          the queue then holds everything the GLFW callbacks and the backend added for the frame.
+     *          Events left in the queue by input trickling are recorded once, when first seen.
+     *
+     *          Log layout (native byte order, checked by the magic on load):
+     *          - header: magic, format version, VIS version, ImGui ini settings at start
+     *          - per frame: flags, delta time, display size when it changed, event count, packed events
+     */
+    class InputRecorder
+    {
+    public:
+        ~InputRecorder();
+        InputRecorder( const InputRecorder& ) = delete;
+        InputRecorder& operator=( const InputRecorder& ) = delete;
+
+        /**
+         * @brief Create the log file, nullptr (after logging the reason) if it cannot be written
+         * @param visVersion Version shown when recording starts, restored before replay
+         * @param iniSettings ImGui window and dock settings the session starts from
+         */
+        static std::unique_ptr<InputRecorder> open(
+            const std::filesystem::path& path, std::string_view visVersion, std::string_view iniSettings );
+
+        void recordFrame();
+
+        size_t frameCount() const
+        {
+            return m_frames;
+        }
+
+        size_t eventCount() const
+        {
+            return m_events;
+        }
+
+    private:
+        InputRecorder() = default;
+
+        std::ofstream m_file;
+        std::vector<uint8_t> m_buffer; ///< One frame, written in a single call
+        uint32_t m_lastEventId = 0;
+        float m_displayWidth = -1.f;
+        float m_displayHeight = -1.f;
+        size_t m_frames = 0;
+        size_t m_events = 0;
+    };
+
+    /**
+     * @brief Feeds a recorded input log back to ImGui, one frame per applyNextFrame()
+     * @details Live input is dropped: events queued since the previous replayed frame are removed
+     *          before the recorded ones are added, and the recorded delta time and display size
+     *          override whatever the platform backend set. Works without any backend.
+     */
+    class InputReplay
+    {
+    public:
+        /**
+         * @brief Load a log, nullptr (after logging the reason) if missing or malformed
+         */
+        static std::unique_ptr<InputReplay> load( const std::filesystem::path& path );
+
+        /**
+         * @brief Apply the next recorded frame, call just before ImGui::NewFrame
+         * @return false once every frame was replayed
+         */
+        bool applyNextFrame();
+
+        bool finished() const
+        {
+            return m_next >= m_frames.size();
+        }
+
+        size_t frameIndex() const
+        {
+            return m_next;
+        }
+
+        size_t frameCount() const
+        {
+            return m_frames.size();
+        }
+
+        const std::string& visVersion() const
+        {
+            return m_visVersion;
+        }
+
+        const std::string& iniSettings() const
+        {
+            return m_iniSettings;
+        }
+
+        /**
+         * @brief Display size of the first frame, for a headless context
+         */
+        float initialWidth() const;
+        float initialHeight() const;
+
+        /**
+         * @brief Sum of the recorded delta times
+         */
+        double recordedSeconds() const;
+
+    private:
+        struct Event
+        {
+            uint8_t type;
+            uint8_t source; ///< Mouse source for mouse events
+            bool down;
+            int32_t code; ///< Key or mouse button
+            float x;      ///< Mouse position, wheel or key analog value
+            float y;
+            uint32_t character;
+        };
+
+        struct Frame
+        {
+            float deltaTime;
+            float displayWidth;
+            float displayHeight;
+            uint32_t firstEvent;
+            uint32_t eventCount;
+        };
+
+        InputReplay() = default;
+
+        std::string m_visVersion;
+        std::string m_iniSettings;
+        std::vector<Frame> m_frames;
+        std::vector<Event> m_events;
+        size_t m_next = 0;
+        uint32_t m_lastEventId = 0; ///< Last event added by the replay, later ones are live input
+    };
+} // namespace nfx::vista
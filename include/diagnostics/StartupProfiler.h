@@ -0,0 +1,105 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace nfx::vista
+{
+    class VersionStore;
+
+    /**
+     * @brief Monotonic timestamps of the startup phases
+     * @details Main thread only. Phases are recorded relative to construction (application start);
+     *          per-version load timings are read from the VersionStore when the report is built.
+     *
+     *          - time to first frame: first frame presented (swap done)
+     *          - time to interactive: first frame presented with the current VIS version's data
+     */
+    class StartupProfiler
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        struct Phase
+        {
+            std::string name;
+            double startMs;
+            double durationMs;
+        };
+
+        /**
+         * @brief Records a phase from construction to destruction
+         */
+        class Scope
+        {
+        public:
+            Scope( StartupProfiler& profiler, const char* name )
+                : m_profiler{ profiler },
+                  m_name{ name },
+                  m_start{ Clock::now() }
+            {
+            }
+
+            ~Scope()
+            {
+                m_profiler.record( m_name, m_start, Clock::now() );
+            }
+
+            Scope( const Scope& ) = delete;
+            Scope& operator=( const Scope& ) = delete;
+
+        private:
+            StartupProfiler& m_profiler;
+            const char* m_name;
+            Clock::time_point m_start;
+        };
+
+        StartupProfiler()
+            : m_origin{ Clock::now() }
+        {
+        }
+
+        Scope scope( const char* name )
+        {
+            return Scope{ *this, name };
+        }
+
+        void record( const char* name, Clock::time_point start, Clock::time_point end );
+
+        void markFirstFrame();
+        void markInteractive();
+
+        bool hasFirstFrame() const
+        {
+            return m_firstFrameMs.has_value();
+        }
+
+        bool isInteractive() const
+        {
+            return m_interactiveMs.has_value();
+        }
+
+        const std::vector<Phase>& phases() const
+        {
+            return m_phases;
+        }
+
+        /**
+         * @brief JSON breakdown: phases, time to first frame/interactive, per-version loads
+         */
+        std::string report( const VersionStore& versions ) const;
+
+    private:
+        double sinceOrigin( Clock::time_point t ) const
+        {
+            return std::chrono::duration<double, std::milli>( t - m_origin ).count();
+        }
+
+        Clock::time_point m_origin;
+        std::vector<Phase> m_phases;
+        std::optional<double> m_firstFrameMs;
+        std::optional<double> m_interactiveMs;
+    };
+} // namespace nfx::vista
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace nfx::vista
+{
+    /**
+     * @brief Process-wide scope tracing, exported as Chrome/Perfetto trace-event JSON
+     * @details Each thread appends complete events to its own buffer: no locks and no shared writes
+     *          after the thread's first event. Buffers grow in fixed-size chunks up to a per-thread cap;
+     *          events past it are counted as dropped. Scopes cost one relaxed load while no capture runs.
+     *
+     *          start(), stop() and write() belong to one controlling thread (the main thread).
+     *          A new capture discards the previous one lazily: each thread resets its own buffer
+     *          on its next event.
+     */
+    class Tracer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Records the duration of its lifetime as one complete event
+         * @details Name and category must outlive the capture (string literals).
+         */
+        class Scope
+        {
+        public:
+            Scope( const char* name, const char* category )
+                : m_name{ name },
+                  m_category{ category }
+            {
+                if( Tracer::isCapturing() )
+                {
+                    m_start = Clock::now();
+                    m_active = true;
+                }
+            }
+
+            ~Scope()
+            {
+                if( m_active )
+                {
+                    Tracer::record( m_name, m_category, m_start, Clock::now() );
+                }
+            }
+
+            Scope( const Scope& ) = delete;
+            Scope& operator=( const Scope& ) = delete;
+
+        private:
+            const char* m_name;
+            const char* m_category;
+            Clock::time_point m_start;
+            bool m_active = false;
+        };
+
+        static Scope scope( const char* name, const char* category )
+        {
+            return Scope{ name, category };
+        }
+
+        /**
+         * @brief Name the calling thread on the timeline
+         */
+        static void setThreadName( std::string name );
+
+        static void start();
+        static void stop();
+
+        static bool isCapturing()
+        {
+            return s_capturing.load( std::memory_order_relaxed );
+        }
+
+        /**
+         * @brief Events recorded by the current capture, across all threads
+         */
+        static size_t eventCount();
+        static size_t droppedCount();
+
+        /**
+         * @brief Write the current capture as trace-event JSON
+         */
+        static bool write( const std::filesystem::path& path );
+
+        /**
+         * @brief Default location for a capture under ProjectSerializer::defaultDir()
+         */
+        static std::filesystem::path defaultPath();
+
+        static void record( const char* name, const char* category, Clock::time_point start, Clock::time_point end );
+
+    private:
+        static std::atomic<bool> s_capturing;
+    };
+} // namespace nfx::vista
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "diagnostics/AllocationTracker.h"
+#include "diagnostics/FrameProfiler.h"
+
+#include <string>
+
+namespace nfx::vista
+{
+    /**
+     * @brief Frame-time breakdown per panel and render stage, allocations and trace capture
+     */
+    class Diagnostics
+    {
+    public:
+        explicit Diagnostics( const FrameProfiler& profiler )
+            : m_profiler{ profiler }
+        {
+        }
+
+        void render();
+
+    private:
+        void renderAllocations();
+        void renderTraceControls();
+
+        const FrameProfiler& m_profiler;
+        FrameProfiler::Section m_plotted = FrameProfiler::Section::Frame;
+        std::string m_lastTrace;                     ///< Path of the last saved capture
+        AllocationTracker::Snapshot m_allocations{}; ///< Main thread counters at the previous render
+    };
+} // namespace nfx::vista
@@ -1,33 +1,71 @@
 #pragma once
 
+#include "AsyncSnapshot.h"
+#include "FrameArena.h"
+
 #include <dnv/vista/sdk/VIS.h>
 #include <imgui.h>
 
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace dnv::vista::sdk
 {
     class VIS;
     class Gmod;
     class GmodPath;
+    class Locations;
 } // namespace dnv::vista::sdk
 
 namespace nfx::vista
 {
+    class GmodIndex;
+    class VersionStore;
+
     class GmodViewer
     {
     public:
-        explicit GmodViewer( const dnv::vista::sdk::VIS& vis );
+        /**
+         * @param workers Runs searches off the UI thread
+         */
+        GmodViewer( const dnv::vista::sdk::VIS& vis, const VersionStore& versions, ThreadPool& workers );
 
-        void render( dnv::vista::sdk::VisVersion version );
+        /**
+         * @return false when the window is hidden and nothing was drawn
+         */
+        bool render( dnv::vista::sdk::VisVersion version );
+
+        /**
+         * @brief Search results popup, rendered after the main window (after render()) while it is visible
+         */
+        void renderOverlay( dnv::vista::sdk::VisVersion version );
 
         const dnv::vista::sdk::GmodNode* selectedNode( dnv::vista::sdk::VisVersion version ) const;
 
+        /**
+         * @brief Select a node, expand it and scroll to it, as clicking a search result does
+         */
+        void revealNode( const dnv::vista::sdk::GmodNode& node, dnv::vista::sdk::VisVersion version );
+
+        /**
+         * @brief Give keyboard focus to the search box on the next frame
+         */
+        void focusSearch()
+        {
+            m_search.focusRequested = true;
+        }
+
+        /**
+         * @brief Also called on a worker when search results are ready: must be thread-safe
+         */
         void setChangeNotifier( std::function<void()> notifier )
         {
+            m_searchResults.setNotifier( notifier );
             m_onChanged = std::move( notifier );
         }
 
@@ -37,11 +75,47 @@ namespace nfx::vista
         }
 
     private:
+        struct SearchMatch
+        {
+            const dnv::vista::sdk::GmodNode* node;
+            const dnv::vista::sdk::GmodNode* functionLeaf; ///< Context badge shown before the node, may be nullptr
+        };
+
+        /**
+         * @brief Matches of one query, computed on a worker
+         */
+        struct SearchResults
+        {
+            std::string query;
+            dnv::vista::sdk::VisVersion version;
+            std::optional<dnv::vista::sdk::GmodPath> parsedPath; ///< The query as a short path, matches then empty
+            std::vector<SearchMatch> matches;
+        };
+
+        /**
+         * @brief Path parse, then substring match over the index's lowercase corpus; runs on a worker
+         * @details Holds a reference to the index so it survives an eviction during the search
+         */
+        static SearchResults search(
+            std::string query,
+            dnv::vista::sdk::VisVersion version,
+            const dnv::vista::sdk::Gmod& gmod,
+            const dnv::vista::sdk::Locations& locations,
+            std::shared_ptr<const GmodIndex> index );
+
         void renderHeader();
         void renderHelp();
-        void renderTree( const dnv::vista::sdk::Gmod& gmod, dnv::vista::sdk::VisVersion version );
-        void renderSearchResults( const dnv::vista::sdk::Gmod& gmod, dnv::vista::sdk::VisVersion version );
-        void renderSearchResultsOverlay( const dnv::vista::sdk::Gmod& gmod, dnv::vista::sdk::VisVersion version );
+        void renderTree( const GmodIndex& index, dnv::vista::sdk::VisVersion version );
+        void renderTreeNode(
+            const GmodIndex& index, uint32_t nodeIndex, uint32_t badgeIndex, dnv::vista::sdk::VisVersion version );
+        void renderSearchResults(
+            const dnv::vista::sdk::Gmod& gmod,
+            const std::shared_ptr<const GmodIndex>& index,
+            dnv::vista::sdk::VisVersion version );
+        void renderSearchResultsOverlay(
+            const dnv::vista::sdk::Gmod& gmod,
+            const std::shared_ptr<const GmodIndex>& index,
+            dnv::vista::sdk::VisVersion version );
 
         std::pair<ImVec4, ImVec4> badgeColors( const dnv::vista::sdk::GmodNode& node ) const;
         bool renderBadge( const dnv::vista::sdk::GmodNode& node );
@@ -50,11 +124,12 @@ namespace nfx::vista
         void selectNode( const dnv::vista::sdk::GmodNode& node, dnv::vista::sdk::VisVersion version );
 
         // Helper methods
-        std::string buildFullPathString( const dnv::vista::sdk::GmodNode* node ) const;
+        FrameString buildFullPathString( const dnv::vista::sdk::GmodNode* node ) const;
         std::optional<dnv::vista::sdk::GmodPath> buildGmodPath(
             const dnv::vista::sdk::GmodNode* node, dnv::vista::sdk::VisVersion version ) const;
 
         const dnv::vista::sdk::VIS& m_vis;
+        const VersionStore& m_versions;
         std::function<void()> m_onChanged;
         std::function<void( std::optional<dnv::vista::sdk::GmodPath> )> m_onNodeSelected;
 
@@ -65,14 +140,19 @@ namespace nfx::vista
             ImVec2 boxPos;
             ImVec2 boxSize;
             bool overlayHovered = false;
+            bool focusRequested = false;
+            std::string requestedQuery; // Last query sent to m_searchResults
+            std::optional<dnv::vista::sdk::VisVersion> requestedVersion;
         };
         SearchState m_search;
+        AsyncSnapshot<SearchResults> m_searchResults;
 
         struct NavigationState
         {
             std::string selectedNodeCode;
             bool scrollToNode = false;
             bool expandSelectedNode = false;
+            std::vector<uint32_t> expandPath; // Ancestors of the target node, opened while scrolling to it
         };
         NavigationState m_navigation;
     };
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "CodebookCache.h"
+#include "LocalIdText.h"
+#include "ThreadPool.h"
+
+#include <dnv/vista/sdk/VIS.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace nfx::vista
+{
+    /**
+     * @brief Batch section of the LocalId builder: one LocalId per location combination
+     * @details The builder's current LocalId is the template. Each combination of number range × sides ×
+     *          verticals is applied to the node of the primary path's first individualizable set, then the
+     *          LocalId is composed and validated. Rows are generated in parallel chunks on the worker pool
+     *          and shown in a virtualized table once complete, ready to copy or export.
+     */
+    class LocalIdBatch
+    {
+    public:
+        LocalIdBatch( const dnv::vista::sdk::VIS& vis, ThreadPool& workers );
+
+        /**
+         * @brief Called on a worker as rows complete: must be thread-safe
+         */
+        void setChangeNotifier( std::function<void()> notifier )
+        {
+            m_onChanged = std::move( notifier );
+        }
+
+        /**
+         * @brief Render the section contents
+         * @param parts Template, generating is disabled unless its primary path is parsed
+         */
+        void render( const LocalIdParts& parts, const std::shared_ptr<const CodebookCache>& codebooks );
+
+    private:
+        struct Row
+        {
+            std::string location;
+            std::string localId;
+            std::string error; // Empty when valid
+        };
+
+        /**
+         * @brief One generation: inputs copied from the template, rows filled by workers
+         */
+        struct Job
+        {
+            dnv::vista::sdk::VisVersion version;
+            std::optional<dnv::vista::sdk::GmodPath> primary;
+            std::string secondaryText; // Empty: no secondary item
+            std::optional<dnv::vista::sdk::GmodPath> secondary;
+            bool verbose = false;
+            MetadataTags tags;
+            std::shared_ptr<const CodebookCache> codebooks;
+
+            // Expansion, decoded from the row index (number slowest, vertical fastest)
+            std::vector<int> numbers; // 0 alone: no number
+            std::string sides;        // '\0' alone: no side
+            std::string verticals;    // '\0' alone: no vertical
+
+            std::vector<Row> rows;
+            std::atomic<size_t> completed{ 0 };
+            std::atomic<bool> cancelled{ false };
+            std::atomic<bool> finished{ false }; // rows may be read once set
+            std::chrono::steady_clock::time_point start;
+            double seconds = 0.0; // Written before finished
+            size_t validCount = 0;
+        };
+
+        /**
+         * @brief Copy or CSV export of a finished job, written on a worker
+         */
+        struct Output
+        {
+            std::string clipboard; // Copy: handed to ImGui on the UI thread once finished
+            std::string status;
+            std::atomic<bool> finished{ false }; // clipboard and status may be read once set
+        };
+
+        static void generateRows( const dnv::vista::sdk::VIS& vis, Job& job, size_t begin, size_t end );
+
+        /**
+         * @brief Count of numbers from numberFrom to numberTo, 0 when the range is empty
+         */
+        size_t numberRange() const;
+
+        void startJob( const LocalIdParts& parts, const std::shared_ptr<const CodebookCache>& codebooks );
+        void renderSpec( dnv::vista::sdk::VisVersion version );
+        void renderResults( const Job& job );
+
+        /**
+         * @brief Build the valid LocalIds for the clipboard, or write the CSV to exportPath, on a worker
+         */
+        void startOutput( bool toClipboard );
+        static bool exportCsv( const Job& job, const std::string& path );
+
+        const dnv::vista::sdk::VIS& m_vis;
+        ThreadPool& m_workers;
+        std::function<void()> m_onChanged;
+
+        // Expansion spec
+        struct
+        {
+            bool useNumbers = true;
+            int numberFrom = 1;
+            int numberTo = 12;
+            std::string sides;     // Selected side codes, e.g. "PS"
+            std::string verticals; // Selected vertical codes
+            std::string exportPath = "localids.csv";
+        } m_spec;
+
+        std::shared_ptr<Job> m_job;       // Latest, shared with its worker tasks
+        std::shared_ptr<Output> m_output; // Latest copy or export of m_job
+    };
+} // namespace nfx::vista
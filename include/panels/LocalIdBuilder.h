@@ -1,11 +1,24 @@
 #pragma once
 
+#include "AsyncSnapshot.h"
+#include "CodebookCache.h"
+#include "GmodIndex.h"
+#include "LocalIdText.h"
+#include "panels/LocalIdBatch.h"
+#include "ShortPathIndex.h"
+
 #include <dnv/vista/sdk/VIS.h>
 
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace dnv::vista::sdk
 {
@@ -15,18 +28,42 @@ namespace dnv::vista::sdk
 
 namespace nfx::vista
 {
+    class VersionStore;
+
     class LocalIdBuilder
     {
     public:
-        explicit LocalIdBuilder( const dnv::vista::sdk::VIS& vis );
+        /**
+         * @param versions Provides the per-version codebook caches
+         * @param workers Runs path parsing and LocalId validation off the UI thread
+         */
+        LocalIdBuilder( const dnv::vista::sdk::VIS& vis, const VersionStore& versions, ThreadPool& workers );
 
-        void render( dnv::vista::sdk::VisVersion version );
+        /**
+         * @return false when the window is hidden and nothing was drawn
+         */
+        bool render( dnv::vista::sdk::VisVersion version );
 
+        /**
+         * @brief Also called on a worker when a parse or validation result is ready: must be thread-safe
+         */
         void setChangeNotifier( std::function<void()> notifier )
         {
+            m_primaryParse.setNotifier( notifier );
+            m_secondaryParse.setNotifier( notifier );
+            m_validation.setNotifier( notifier );
+            m_batch.setChangeNotifier( notifier );
             m_onChanged = std::move( notifier );
         }
 
+        /**
+         * @brief Asks for a frame after a delay without input, to start a debounced parse
+         */
+        void setWakeRequest( std::function<void( double seconds )> request )
+        {
+            m_onWakeRequest = std::move( request );
+        }
+
         void setCurrentGmodPath( const std::optional<dnv::vista::sdk::GmodPath>& path )
         {
             m_currentGmodPath = path;
@@ -37,6 +74,7 @@ namespace nfx::vista
             m_state.primaryPath = path.toString();
             m_state.primaryPathOpt = path;
             m_state.primaryPathDirty = false;
+            m_state.primaryPathPending = false;
             if( m_onChanged )
             {
                 m_onChanged();
@@ -49,28 +87,131 @@ namespace nfx::vista
             m_state.secondaryPath = path.toString();
             m_state.secondaryPathOpt = path;
             m_state.secondaryPathDirty = false;
+            m_state.secondaryPathPending = false;
             if( m_onChanged )
             {
                 m_onChanged();
             }
         }
 
+        /**
+         * @brief Set a metadata tag value, empty to clear it
+         */
+        void setMetadataTag( dnv::vista::sdk::CodebookName name, std::string value );
+
     private:
+        /**
+         * @brief Result of parsing a path text on a worker
+         */
+        struct PathParse
+        {
+            std::string text;
+            std::optional<dnv::vista::sdk::GmodPath> path;
+            std::vector<std::string> errors;       // Messages of a failed parse
+            std::pair<size_t, size_t> errorSpan{}; // Offending part of text, empty if unknown
+        };
+
+        /**
+         * @brief Result of validating a generated LocalId on a worker
+         */
+        struct Validation
+        {
+            std::string localId;
+            dnv::vista::sdk::ParsingErrors errors;
+        };
+
+        /**
+         * @brief Request a parse when the text changed, adopt the result once it matches the text
+         */
+        void syncPath(
+            AsyncSnapshot<PathParse>& parse,
+            const std::string& text,
+            bool& dirty,
+            bool& pending,
+            std::optional<dnv::vista::sdk::GmodPath>& path,
+            dnv::vista::sdk::VisVersion version );
+
+        /**
+         * @brief Completions of the segment being typed at the end of a path input
+         */
+        struct PathSuggestions
+        {
+            std::string text;                      // Input text the suggestions were computed for
+            const ShortPathIndex* table = nullptr; // Table the nodes index into
+            size_t segmentBegin = 0;               // Start of the segment being typed in text
+            std::span<const uint32_t> nodes;       // Next segments whose code starts with the typed one
+            std::vector<std::pair<char, std::string_view>> locations; // Codes for an individualizable node
+            bool hovered = false;                  // Keeps the list open while clicking it
+        };
+
+        /**
+         * @brief Recompute suggestions when the text or the version's table changed
+         */
+        void updateSuggestions(
+            PathSuggestions& suggestions, const std::string& text, dnv::vista::sdk::VisVersion version );
+
+        /**
+         * @brief List under an active path input
+         * @return true when a suggestion was accepted into text
+         */
+        bool renderSuggestions( const char* id, PathSuggestions& suggestions, std::string& text, bool inputActive );
+
+        /**
+         * @brief Debounce typing in a path input
+         * @param editTime ImGui time of the last unparsed edit, negative if none
+         * @return true when the text should be parsed now
+         */
+        bool debounceEdit( bool edited, bool committed, double& editTime );
+
+        /**
+         * @brief Parse result, with the offending segment highlighted when the path is invalid
+         */
+        void renderPathStatus(
+            const AsyncSnapshot<PathParse>& parse,
+            const std::string& text,
+            bool pending,
+            const std::optional<dnv::vista::sdk::GmodPath>& path );
+
+        /**
+         * @brief Refresh m_location and m_locationButtons when the selection or version changed
+         */
+        void updateLocation( dnv::vista::sdk::VisVersion version );
+
         void renderPrimaryItemSection( dnv::vista::sdk::VisVersion version );
         void renderSecondaryItemSection( dnv::vista::sdk::VisVersion version );
         void renderLocationSection( dnv::vista::sdk::VisVersion version );
-        void renderMetadataSection( dnv::vista::sdk::VisVersion version );
+        void renderMetadataSection();
         void renderOutputSection( dnv::vista::sdk::VisVersion version );
+        void renderBatchSection( dnv::vista::sdk::VisVersion version );
+
+        /**
+         * @brief The current inputs, pointing into m_state
+         */
+        LocalIdParts currentParts( dnv::vista::sdk::VisVersion version ) const;
+
+        /**
+         * @brief Hash of everything the generated LocalId depends on
+         */
+        uint64_t outputFingerprint( dnv::vista::sdk::VisVersion version ) const;
+
+        /**
+         * @brief Rebuild generatedLocalId through the SDK and request its validation
+         */
+        void generateLocalId( dnv::vista::sdk::VisVersion version );
 
         void renderMetadataInput(
             const char* id, const char* label, std::string& value, dnv::vista::sdk::CodebookName codebook );
 
         const dnv::vista::sdk::VIS& m_vis;
+        const VersionStore& m_versions;
         std::function<void()> m_onChanged;
+        std::function<void( double seconds )> m_onWakeRequest;
         std::optional<dnv::vista::sdk::GmodPath> m_currentGmodPath;
 
-        std::unordered_map<dnv::vista::sdk::CodebookName, std::vector<std::string>> m_codebookCache;
-        std::optional<dnv::vista::sdk::VisVersion> m_cachedVersion;
+        // Of the version being rendered
+        std::shared_ptr<const CodebookCache> m_codebooks;
+        std::shared_ptr<const GmodIndex> m_gmodIndex;
+        std::shared_ptr<const ShortPathIndex> m_shortPaths; // Over m_gmodIndex
 
         // Builder state
         struct
@@ -80,25 +221,22 @@ namespace nfx::vista
             bool hasSecondaryItem = false;
             bool verboseMode = false;
 
-            // Cached parsed paths — invalidated when path text changes
+            // Cached parsed paths — invalidated when path text changes, reparsed on a worker
             std::optional<dnv::vista::sdk::GmodPath> primaryPathOpt;
             std::optional<dnv::vista::sdk::GmodPath> secondaryPathOpt;
             bool primaryPathDirty = true;
             bool secondaryPathDirty = true;
+            bool primaryPathPending = false; // Parse requested or debouncing, result not adopted yet
+            bool secondaryPathPending = false;
+            double primaryEditTime = -1.0; // See debounceEdit()
+            double secondaryEditTime = -1.0;
 
-            // Metadata tags
-            std::string quantity;
-            std::string content;
-            std::string position;
-            std::string calculation;
-            std::string state;
-            std::string command;
-            std::string type;
-            std::string detail;
+            MetadataTags tags;
 
             // Output
             std::string generatedLocalId;
-            dnv::vista::sdk::ParsingErrors errors;
+            std::string requestedValidation; // Last LocalId sent to m_validation
+            std::optional<uint64_t> outputFingerprint; // Inputs generatedLocalId was built from
 
             // Location builder state
             int locationNumber = 0;      // 0 = none
@@ -108,6 +246,62 @@ namespace nfx::vista
             char locationLong = 0;       // 0 = none, 'F'/'A'
         } m_state;
 
-        std::unordered_map<dnv::vista::sdk::CodebookName, std::string> m_comboFilters;
+        /**
+         * @brief Standard-value picker filter, with its result kept until the text or version changes
+         */
+        struct ComboFilter
+        {
+            std::string text;
+            std::string appliedText;              // text the matches were computed for
+            std::string lowerText;                // Reused buffer
+            const CodebookCache* cache = nullptr; // Cache the matches index into
+            std::vector<uint32_t> matches;
+        };
+
+        std::unordered_map<dnv::vista::sdk::CodebookName, ComboFilter> m_comboFilters;
+
+        /**
+         * @brief Location section selection a built location belongs to
+         */
+        struct LocationKey
+        {
+            dnv::vista::sdk::VisVersion version;
+            int number;
+            char side;
+            char vertical;
+            char transverse;
+            char longitudinal;
+
+            bool operator==( const LocationKey& ) const = default;
+        };
+
+        struct
+        {
+            std::optional<LocationKey> key;
+            std::string value; // Empty when no component is set or the combination is invalid
+            bool hasAnyComponent = false;
+        } m_location;
+
+        struct LocationButton
+        {
+            char code;
+            std::string label; // "P  Port##side"
+        };
+
+        struct
+        {
+            std::optional<dnv::vista::sdk::VisVersion> version;
+            std::unordered_map<dnv::vista::sdk::LocationGroup, std::vector<LocationButton>> groups;
+        } m_locationButtons;
+
+        PathSuggestions m_primarySuggestions;
+        PathSuggestions m_secondarySuggestions;
+
+        // Published by workers, read by render()
+        AsyncSnapshot<PathParse> m_primaryParse;
+        AsyncSnapshot<PathParse> m_secondaryParse;
+        AsyncSnapshot<Validation> m_validation;
+
+        LocalIdBatch m_batch;
     };
 } // namespace nfx::vista
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "ThreadPool.h"
+
+#include <dnv/vista/sdk/VIS.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nfx::vista
+{
+    /**
+     * @brief Bulk LocalId validation: paste a block of text or load a file, one LocalId per line
+     * @details The source is moved into a job and split into line views over it without copying. Lines are
+     *          parsed with LocalId::fromString in parallel chunks on the worker pool while the panel shows
+     *          progress; the finished rows are shown in a virtualized table with the parser's errors and
+     *          links to the primary and secondary item nodes.
+     */
+    class LocalIdInspector
+    {
+    public:
+        LocalIdInspector( const dnv::vista::sdk::VIS& vis, ThreadPool& workers );
+
+        /**
+         * @return false when the window is hidden and nothing was drawn
+         */
+        bool render();
+
+        /**
+         * @brief Called on a worker as lines are parsed: must be thread-safe
+         */
+        void setChangeNotifier( std::function<void()> notifier )
+        {
+            m_onChanged = std::move( notifier );
+        }
+
+        /**
+         * @brief Clicking a node link: reveal the node in the Gmod of its LocalId's version
+         */
+        void setNodeLinkCallback(
+            std::function<void( const dnv::vista::sdk::GmodNode&, dnv::vista::sdk::VisVersion )> callback )
+        {
+            m_onNodeLink = std::move( callback );
+        }
+
+    private:
+        struct Row
+        {
+            std::string_view line; // Into Job::text
+            uint32_t lineNumber = 0;
+            bool valid = false;
+            dnv::vista::sdk::VisVersion version{};
+            const dnv::vista::sdk::GmodNode* primary = nullptr; // In the VIS Gmod of version
+            const dnv::vista::sdk::GmodNode* secondary = nullptr;
+            std::string errors; // Parser messages, one per line
+        };
+
+        /**
+         * @brief One inspection: owns the text its rows view, filled by workers
+         */
+        struct Job
+        {
+            std::string text;
+            std::string filePath; // Read by the first worker task when set
+            std::string loadError;
+
+            std::vector<Row> rows;
+            std::atomic<size_t> total{ 0 }; // Set once rows are split, 0 before
+            std::atomic<size_t> completed{ 0 };
+            std::atomic<bool> cancelled{ false };
+            std::atomic<bool> finished{ false }; // rows may be read once set
+
+            // Written before finished
+            std::chrono::steady_clock::time_point start;
+            double splitSeconds = 0.0;
+            double parseSeconds = 0.0;
+            size_t validCount = 0;
+            std::vector<uint32_t> invalidRows;
+        };
+
+        static void splitLines( Job& job );
+        static void parseRows( const dnv::vista::sdk::VIS& vis, Job& job, size_t begin, size_t end );
+
+        void startJob( std::string text, std::string filePath );
+        void renderSource();
+        void renderResults( const Job& job );
+        void renderNodeLink( const dnv::vista::sdk::GmodNode* node, dnv::vista::sdk::VisVersion version );
+
+        const dnv::vista::sdk::VIS& m_vis;
+        ThreadPool& m_workers;
+        std::function<void()> m_onChanged;
+        std::function<void( const dnv::vista::sdk::GmodNode&, dnv::vista::sdk::VisVersion )> m_onNodeLink;
+
+        struct
+        {
+            std::string text;
+            std::string filePath;
+            bool invalidOnly = false;
+        } m_input;
+
+        std::shared_ptr<Job> m_job;
+    };
+} // namespace nfx::vista
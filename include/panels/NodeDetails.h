@@ -13,11 +13,18 @@ namespace nfx::vista
     public:
         NodeDetails() = default;
 
-        void render();
-
+        /**
+         * @return false when the window is hidden and nothing was drawn
+         */
+        bool render();
+
+        /**
+         * @brief Path strings are rebuilt on the next visible frame, not per selection
+         */
         void setCurrentGmodPath( const std::optional<dnv::vista::sdk::GmodPath>& path )
         {
             m_currentGmodPath = path;
+            m_pathStrings.dirty = true;
         }
 
         void setUsePrimaryCallback( std::function<void( const dnv::vista::sdk::GmodPath& )> cb )
@@ -32,6 +39,14 @@ namespace nfx::vista
 
     private:
         std::optional<dnv::vista::sdk::GmodPath> m_currentGmodPath;
+
+        struct PathStrings
+        {
+            std::string shortPath;
+            std::string fullPath;
+            bool dirty = false;
+        };
+        PathStrings m_pathStrings; ///< Of m_currentGmodPath, formatted once per selection
         std::function<void( const dnv::vista::sdk::GmodPath& )> m_onUsePrimary;
         std::function<void( const dnv::vista::sdk::GmodPath& )> m_onUseSecondary;
     };
@@ -0,0 +1,42 @@
+#pragma once
+
+namespace nfx::vista
+{
+    /**
+     * @brief Whether a panel drew its contents this frame, fed with the result of its render()
+     * @details A panel is hidden when closed, collapsed, behind another dock tab or fully clipped:
+     *          ImGui::Begin returns false and the panel skips its model work. Work that depends on
+     *          hidden panels is skipped too, and whatever they missed is caught up on the first
+     *          visible frame (becameVisible()).
+     */
+    class PanelVisibility
+    {
+    public:
+        /**
+         * @return visible, for use as a condition
+         */
+        bool update( bool visible )
+        {
+            m_becameVisible = visible && !m_visible;
+            m_visible = visible;
+            return visible;
+        }
+
+        bool isVisible() const
+        {
+            return m_visible;
+        }
+
+        /**
+         * @brief Visible this frame after being hidden (or never shown) the previous one
+         */
+        bool becameVisible() const
+        {
+            return m_becameVisible;
+        }
+
+    private:
+        bool m_visible = false;
+        bool m_becameVisible = false;
+    };
+} // namespace nfx::vista
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "AsyncSnapshot.h"
 #include "Project.h"
 #include "ProjectSerializer.h"
 
@@ -14,9 +15,15 @@ namespace nfx::vista
     class ProjectManager
     {
     public:
-        ProjectManager();
+        /**
+         * @param workers Runs directory listings for the file browser
+         */
+        explicit ProjectManager( ThreadPool& workers );
 
-        void render();
+        /**
+         * @return false when the window is hidden and nothing was drawn
+         */
+        bool render();
 
         bool hasActiveProject() const
         {
@@ -25,9 +32,13 @@ namespace nfx::vista
         const Project* activeProject() const;
         Project* activeProject();
 
+        /**
+         * @brief Also called on a worker when a directory listing is ready: must be thread-safe
+         */
         void setChangeNotifier( std::function<void()> notifier )
         {
-            m_onChanged = std::move( notifier );
+            m_onChanged = notifier;
+            m_browserListing.setNotifier( std::move( notifier ) );
         }
 
     private:
@@ -51,7 +62,18 @@ namespace nfx::vista
             bool isDirectory = false;
         };
 
-        void refreshBrowserEntries();
+        struct BrowserListing
+        {
+            std::filesystem::path directory;
+            std::vector<BrowserEntry> entries;
+        };
+
+        /**
+         * @brief Directories then .json files, sorted by name; runs on a worker
+         */
+        static BrowserListing listDirectory( const std::filesystem::path& directory );
+
+        void requestBrowserListing();
 
         std::optional<Project> m_activeProject;
         std::function<void()> m_onChanged;
@@ -73,9 +95,9 @@ namespace nfx::vista
 
         // Shared file browser state (used by Open and Save As)
         std::filesystem::path m_browserCurrentDir;
-        std::vector<BrowserEntry> m_browserEntries;
+        AsyncSnapshot<BrowserListing> m_browserListing;
         std::string m_browserFileName; // editable filename (Save As) or selected path (Open)
-        bool m_browserDirty = true;    // true = needs refreshBrowserEntries()
+        bool m_browserDirty = true;    // true = needs requestBrowserListing()
 
         // Status bar
         std::string m_statusMessage;
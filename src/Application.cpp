@@ -1,9 +1,19 @@
 #include "Application.h"
+#include "DrawDataHash.h"
+#include "FrameArena.h"
+#include "HeadlessImGui.h"
+#include "ThreadPool.h"
+#include "VersionStore.h"
 #include "config/Theme.h"
+#include "diagnostics/AllocationTracker.h"
+#include "diagnostics/InputRecording.h"
+#include "diagnostics/Tracer.h"
 #include "panels/GmodViewer.h"
 #include "panels/NodeDetails.h"
 #include "panels/LocalIdBuilder.h"
+#include "panels/LocalIdInspector.h"
 #include "panels/ProjectManager.h"
+#include "panels/Diagnostics.h"
 
 #include <GLFW/glfw3.h>
 #include <imgui.h>
@@ -11,17 +21,36 @@
 #include <imgui_impl_opengl3.h>
 #include <imgui_internal.h>
 
+#include <dnv/vista/sdk/Transport.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <iterator>
+#include <numeric>
+#include <thread>
 
 using namespace dnv::vista::sdk;
 
 namespace nfx::vista
 {
-    Application::Application()
-        : m_window{ nullptr },
-          m_vis{ &VIS::instance() }
+    Application::Application( const LaunchOptions& options )
+        : m_options{ options },
+          m_window{ nullptr }
     {
+        Tracer::setThreadName( "main" );
+        if( !m_options.tracePath.empty() )
+        {
+            Tracer::start();
+        }
+
+        {
+            auto phase = m_startup.profiler.scope( "vis.instance" );
+            m_vis.instance = &VIS::instance();
+        }
+
         auto versions = m_vis.instance->versions();
         m_vis.versionIndex = versions.size() - 1;
         m_vis.currentVersion = versions[m_vis.versionIndex];
@@ -33,50 +62,172 @@ namespace nfx::vista
 
     bool Application::initialize()
     {
-        if( !initializeWindow() )
+        auto& profiler = m_startup.profiler;
+
+        // Start loading VIS data first so it overlaps with window and ImGui setup
         {
-            return false;
+            auto phase = profiler.scope( "versionStore.start" );
+            initializeVersionStore();
         }
 
-        if( !initializeImGui() )
+        // Headless replay: no GLFW at all, ImGui runs without platform or renderer backend
+        if( !m_options.headless )
         {
-            return false;
+            if( !initializeWindow() )
+            {
+                return false;
+            }
+
+            // Workers may post events from now on; versions loaded meanwhile are caught up by this one
+            m_rendering.mode.setEventsReady();
         }
 
-        initializePanels();
-        connectPanels();
-        initializeStatus();
+        {
+            auto phase = profiler.scope( "imgui.init" );
+            if( !initializeImGui() )
+            {
+                return false;
+            }
+        }
 
-        return true;
+        {
+            auto phase = profiler.scope( "panels.init" );
+            initializePanels();
+            connectPanels();
+        }
+
+        {
+            auto phase = profiler.scope( "status.init" );
+            initializeStatus();
+        }
+
+        return initializeInput();
     }
 
     void Application::run()
     {
-        while( !glfwWindowShouldClose( m_window.handle ) )
+        while( isRunning() )
         {
+            if( m_input.recorder || m_input.replay )
+            {
+                waitForPendingLoads();
+            }
+
+            m_rendering.mode.frameStarted();
+
             if( m_rendering.mode.mode() != RenderingMode::Mode::EventDriven )
             {
                 calcFps();
             }
 
-            beginFrame();
-            renderFrame();
-            endFrame();
+            // Ready before the frame starts means the frame renders it (the displayed version is never evicted)
+            const bool dataReady = m_vis.store->isReady( m_vis.currentVersion );
+
+            {
+                auto frame = m_rendering.profiler.scope( FrameProfiler::Section::Frame );
+                auto trace = Tracer::scope( "frame", "frame" );
 
-            m_rendering.mode.waitOrPollEvents();
+                if( !m_startup.profiler.hasFirstFrame() )
+                {
+                    // The first NewFrame builds the font atlas and the backend GL objects
+                    auto& profiler = m_startup.profiler;
+                    {
+                        auto phase = profiler.scope( "firstFrame.newFrame" );
+                        beginFrame();
+                    }
+                    {
+                        auto phase = profiler.scope( "firstFrame.build" );
+                        renderFrame();
+                    }
+                    {
+                        auto phase = profiler.scope( "firstFrame.render" );
+                        endFrame();
+                    }
+                    profiler.markFirstFrame();
+                }
+                else
+                {
+                    beginFrame();
+                    renderFrame();
+                    endFrame();
+                }
+            }
+            m_rendering.profiler.endFrame( m_rendering.lastFramePresented );
+
+            if( m_input.replay )
+            {
+                m_input.frameMs.push_back( m_rendering.profiler.latest( FrameProfiler::Section::Frame ) );
+                if( m_input.replay->finished() )
+                {
+                    finishReplay();
+                }
+            }
+
+            // Interactive once a presented frame showed the current version's data
+            if( dataReady )
+            {
+                m_startup.profiler.markInteractive();
+            }
+
+            if( m_options.startupReport && !m_startup.reported && m_startup.profiler.isInteractive() &&
+                !m_vis.store->isLoading() )
+            {
+                writeStartupReport();
+            }
+
+            // Between frames: no panel holds on to version data here
+            m_vis.store->trim();
+
+            // Once the switched-to version is on screen, warm up the ones likely to be picked next
+            if( m_vis.prefetchAfterSwitch && dataReady )
+            {
+                m_vis.prefetchAfterSwitch = false;
+                prefetchAround( m_vis.currentVersion );
+            }
+
+            if( m_input.replay )
+            {
+                // Frames back to back: the recording provides the timing, the window only has to stay responsive
+                if( m_window.handle )
+                {
+                    glfwPollEvents();
+                }
+            }
+            else
+            {
+                auto trace = Tracer::scope( "waitOrPollEvents", "frame" );
+                m_rendering.mode.waitOrPollEvents( m_rendering.lastFramePresented );
+            }
         }
 
         shutdown();
     }
 
+    void Application::initializeVersionStore()
+    {
+        m_workers = std::make_unique<ThreadPool>();
+        m_vis.store = std::make_unique<VersionStore>( *m_vis.instance, *m_workers );
+        m_vis.store->setMemoryBudget( m_options.memoryBudgetBytes );
+
+        // Runs on worker threads and wakes the loop in every mode. Loads start before glfwInit, and headless
+        // replay never initializes GLFW: wake() does nothing until the window is up
+        m_vis.store->setChangeNotifier( [this]() { m_rendering.mode.wake(); } );
+        m_vis.store->preloadAll();
+    }
+
     bool Application::initializeWindow()
     {
-        if( !glfwInit() )
         {
-            std::cerr << "Failed to initialize GLFW\n";
-            return false;
+            auto phase = m_startup.profiler.scope( "glfw.init" );
+            if( !glfwInit() )
+            {
+                std::cerr << "Failed to initialize GLFW\n";
+                return false;
+            }
         }
 
+        auto phase = m_startup.profiler.scope( "window.create" );
+
         glfwWindowHint( GLFW_CONTEXT_VERSION_MAJOR, 4 );
         glfwWindowHint( GLFW_CONTEXT_VERSION_MINOR, 5 );
 
@@ -93,12 +244,32 @@ namespace nfx::vista
         glfwMakeContextCurrent( m_window.handle );
         glfwSwapInterval( 1 );
 
+        m_rendering.mode.setMode( m_options.renderingMode );
+        m_rendering.mode.setTargetFps( m_options.targetFps );
+        m_rendering.mode.setWindow( m_window.handle );
+
+        // Expose/damage: the last presented image is gone, so the next frame must be submitted
+        glfwSetWindowUserPointer( m_window.handle, this );
+        glfwSetWindowRefreshCallback( m_window.handle, []( GLFWwindow* window ) {
+            auto* app = static_cast<Application*>( glfwGetWindowUserPointer( window ) );
+            app->m_rendering.forceRedraw = true;
+        } );
+
         return true;
     }
 
     bool Application::initializeImGui()
     {
+        if( !m_window.handle )
+        {
+            // The replayed frames set the display size and time step
+            m_input.headless = std::make_unique<HeadlessImGui>( ImVec2( 1280.0f, 720.0f ) );
+            ImGui::GetIO().ConfigFlags |= ImGuiConfigFlags_DockingEnable;
+            return true;
+        }
+
         IMGUI_CHECKVERSION();
+        ImGui::SetAllocatorFunctions( &AllocationTracker::imguiAlloc, &AllocationTracker::imguiFree );
         auto ctx = ImGui::CreateContext();
 
         if( !ctx )
@@ -128,14 +299,22 @@ namespace nfx::vista
 
     void Application::initializePanels()
     {
-        m_panels.gmodViewer = std::make_unique<GmodViewer>( *m_vis.instance );
+        m_panels.gmodViewer = std::make_unique<GmodViewer>( *m_vis.instance, *m_vis.store, *m_workers );
         m_panels.nodeDetails = std::make_unique<NodeDetails>();
-        m_panels.localIdBuilder = std::make_unique<LocalIdBuilder>( *m_vis.instance );
-        m_panels.projectManager = std::make_unique<ProjectManager>();
+        m_panels.localIdBuilder = std::make_unique<LocalIdBuilder>( *m_vis.instance, *m_vis.store, *m_workers );
+        m_panels.localIdInspector = std::make_unique<LocalIdInspector>( *m_vis.instance, *m_workers );
+        m_panels.projectManager = std::make_unique<ProjectManager>( *m_workers );
+        m_panels.diagnostics = std::make_unique<Diagnostics>( m_rendering.profiler );
     }
 
     void Application::initializeStatus()
     {
+        if( !m_window.handle )
+        {
+            m_status.rendererName = "none (headless)";
+            return;
+        }
+
         if( const GLubyte* renderer = glGetString( GL_RENDERER ) )
         {
             m_status.rendererName = reinterpret_cast<const char*>( renderer );
@@ -145,13 +324,61 @@ namespace nfx::vista
         {
             m_status.glVersion = reinterpret_cast<const char*>( version );
         }
+    }
+
+    bool Application::initializeInput()
+    {
+        if( !m_options.replayInputPath.empty() )
+        {
+            m_input.replay = InputReplay::load( m_options.replayInputPath );
+            if( !m_input.replay )
+            {
+                return false;
+            }
+
+            const auto versions = m_vis.instance->versions();
+            const auto it = std::find_if( versions.begin(), versions.end(), [this]( VisVersion v ) {
+                return VisVersions::toString( v ) == m_input.replay->visVersion();
+            } );
+            if( it == versions.end() )
+            {
+                std::cerr << "Recording uses VIS " << m_input.replay->visVersion() << ", not available in this build\n";
+                return false;
+            }
+            m_vis.versionIndex = static_cast<int>( std::distance( versions.begin(), it ) );
+            m_vis.currentVersion = *it;
+
+            // Start from the recorded window and dock settings, and never write them back
+            const std::string& ini = m_input.replay->iniSettings();
+            ImGui::GetIO().IniFilename = nullptr;
+            ImGui::LoadIniSettingsFromMemory( ini.data(), ini.size() );
+
+            m_input.frameMs.reserve( m_input.replay->frameCount() );
+        }
+        else if( !m_options.recordInputPath.empty() )
+        {
+            // ImGui loads its settings on the first NewFrame: keep the file the session starts from
+            std::string ini;
+            if( const char* iniFile = ImGui::GetIO().IniFilename )
+            {
+                std::ifstream f( iniFile, std::ios::binary );
+                ini.assign( std::istreambuf_iterator<char>( f ), std::istreambuf_iterator<char>() );
+            }
 
-        const auto& gmod = m_vis.instance->gmod( m_vis.currentVersion );
-        m_status.nodeCount = static_cast<size_t>( std::distance( gmod.begin(), gmod.end() ) );
+            m_input.recorder =
+                InputRecorder::open( m_options.recordInputPath, VisVersions::toString( m_vis.currentVersion ), ini );
+            if( !m_input.recorder )
+            {
+                return false;
+            }
+        }
+
+        return true;
     }
 
     void Application::connectPanels()
     {
+        // Notifiers run on workers; notifyChange() posts nothing before the window is up, nor ever when headless
         m_panels.gmodViewer->setChangeNotifier( [this]() { m_rendering.mode.notifyChange(); } );
         m_panels.gmodViewer->setNodeSelectionCallback( [this]( std::optional<GmodPath> path ) {
             m_currentGmodPath = path;
@@ -161,6 +388,27 @@ namespace nfx::vista
         } );
 
         m_panels.localIdBuilder->setChangeNotifier( [this]() { m_rendering.mode.notifyChange(); } );
+        m_panels.localIdBuilder->setWakeRequest( [this]( double seconds ) { m_rendering.mode.wakeAfter( seconds ); } );
+
+        m_panels.localIdInspector->setChangeNotifier( [this]() { m_rendering.mode.notifyChange(); } );
+        m_panels.localIdInspector->setNodeLinkCallback( [this]( const GmodNode& node, VisVersion version ) {
+            // A LocalId of another version switches the viewer to it, as the VIS menu does
+            if( version != m_vis.currentVersion )
+            {
+                const auto versions = m_vis.instance->versions();
+                const auto it = std::find( versions.begin(), versions.end(), version );
+                if( it == versions.end() )
+                {
+                    return;
+                }
+                m_vis.versionIndex = static_cast<int>( std::distance( versions.begin(), it ) );
+                m_vis.currentVersion = version;
+                m_vis.prefetchAfterSwitch = true;
+            }
+            m_ui.showGmodViewer = true;
+            m_panels.gmodViewer->revealNode( node, version );
+            m_rendering.mode.notifyChange();
+        } );
 
         m_panels.nodeDetails->setUsePrimaryCallback( [this]( const dnv::vista::sdk::GmodPath& path ) {
             m_panels.localIdBuilder->setPrimaryPath( path );
@@ -176,13 +424,41 @@ namespace nfx::vista
 
     void Application::beginFrame()
     {
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
+        auto timer = m_rendering.profiler.scope( FrameProfiler::Section::NewFrame );
+        auto trace = Tracer::scope( "Application::beginFrame", "frame" );
+
+        // Transient strings of the previous frame are gone: the panels build this frame's from scratch
+        FrameArena::reset();
+
+        // Events queued by the GLFW callbacks since the last frame: the user is interacting
+        if( !ImGui::GetCurrentContext()->InputEventsQueue.empty() )
+        {
+            m_rendering.mode.notifyInput();
+        }
+
+        if( m_window.handle )
+        {
+            ImGui_ImplOpenGL3_NewFrame();
+            ImGui_ImplGlfw_NewFrame();
+        }
+
+        // After the backend: the queue now holds everything the callbacks and the backend added
+        if( m_input.replay )
+        {
+            m_input.replay->applyNextFrame();
+        }
+        else if( m_input.recorder )
+        {
+            m_input.recorder->recordFrame();
+        }
+
         ImGui::NewFrame();
     }
 
     void Application::renderFrame()
     {
+        auto trace = Tracer::scope( "Application::renderFrame", "frame" );
+
         ImGuiViewport* viewport = ImGui::GetMainViewport();
 
         ImGui::SetNextWindowPos( viewport->WorkPos );
@@ -220,17 +496,46 @@ namespace nfx::vista
 
     void Application::endFrame()
     {
-        ImGui::Render();
+        auto trace = Tracer::scope( "Application::endFrame", "frame" );
+
+        if( !m_window.handle )
+        {
+            // Headless replay: draw data is built for the timings, there is nothing to present
+            auto timer = m_rendering.profiler.scope( FrameProfiler::Section::Submit );
+            m_input.headless->render();
+            return;
+        }
+
+        {
+            auto timer = m_rendering.profiler.scope( FrameProfiler::Section::Submit );
 
-        int display_w, display_h;
-        glfwGetFramebufferSize( m_window.handle, &display_w, &display_h );
-        glViewport( 0, 0, display_w, display_h );
-        glClearColor( 0.1f, 0.1f, 0.12f, 1.0f );
-        glClear( GL_COLOR_BUFFER_BIT );
+            ImGui::Render();
 
-        ImGui_ImplOpenGL3_RenderDrawData( ImGui::GetDrawData() );
+            int display_w, display_h;
+            glfwGetFramebufferSize( m_window.handle, &display_w, &display_h );
 
-        glfwSwapBuffers( m_window.handle );
+            // Same draw data as the frame on screen: skip the GL work and the swap
+            const auto hash = hashDrawData( *ImGui::GetDrawData(), display_w, display_h );
+            if( hash.has_value() && hash == m_rendering.presentedHash && !m_rendering.forceRedraw )
+            {
+                m_rendering.lastFramePresented = false;
+                return;
+            }
+            m_rendering.presentedHash = hash;
+            m_rendering.forceRedraw = false;
+            m_rendering.lastFramePresented = true;
+
+            glViewport( 0, 0, display_w, display_h );
+            glClearColor( 0.1f, 0.1f, 0.12f, 1.0f );
+            glClear( GL_COLOR_BUFFER_BIT );
+
+            ImGui_ImplOpenGL3_RenderDrawData( ImGui::GetDrawData() );
+        }
+
+        {
+            auto timer = m_rendering.profiler.scope( FrameProfiler::Section::Present );
+            glfwSwapBuffers( m_window.handle );
+        }
     }
 
     void Application::renderMenuBar()
@@ -241,25 +546,47 @@ namespace nfx::vista
             {
                 if( ImGui::MenuItem( "Exit" ) )
                 {
-                    glfwSetWindowShouldClose( m_window.handle, true );
+                    requestQuit();
                 }
                 ImGui::EndMenu();
             }
 
             if( ImGui::BeginMenu( "VIS" ) )
             {
+                // Menu open: the user is about to pick, start loading the likely candidates
+                prefetchAround( m_vis.currentVersion );
+
                 auto versions = m_vis.instance->versions();
                 for( size_t i = 0; i < versions.size(); ++i )
                 {
                     bool isSelected = ( i == m_vis.versionIndex );
-                    if( ImGui::MenuItem( VisVersions::toString( versions[i] ).data(), nullptr, isSelected ) )
+                    const char* hint = nullptr;
+                    switch( m_vis.store->state( versions[i] ) )
                     {
+                        case VersionStore::State::Ready:
+                            break;
+                        case VersionStore::State::Evicted:
+                            hint = "unloaded";
+                            break;
+                        case VersionStore::State::Failed:
+                            hint = "failed";
+                            break;
+                        default:
+                            hint = "loading";
+                            break;
+                    }
+                    if( ImGui::MenuItem( VisVersions::toString( versions[i] ).data(), hint, isSelected ) )
+                    {
+                        // Data lives in the store: switching only changes which entry the panels read
                         m_vis.versionIndex = i;
                         m_vis.currentVersion = versions[i];
-                        const auto& gmod = m_vis.instance->gmod( m_vis.currentVersion );
-                        m_status.nodeCount = static_cast<size_t>( std::distance( gmod.begin(), gmod.end() ) );
+                        m_vis.prefetchAfterSwitch = true;
                         m_rendering.mode.notifyChange();
                     }
+                    else if( ImGui::IsItemHovered() )
+                    {
+                        m_vis.store->prefetch( versions[i] );
+                    }
                 }
                 ImGui::EndMenu();
             }
@@ -278,10 +605,18 @@ namespace nfx::vista
                 {
                     m_rendering.mode.notifyChange();
                 }
+                if( ImGui::MenuItem( "LocalId Inspector", nullptr, &m_ui.showLocalIdInspector ) )
+                {
+                    m_rendering.mode.notifyChange();
+                }
                 if( ImGui::MenuItem( "Project Manager", nullptr, &m_ui.showProjectManager ) )
                 {
                     m_rendering.mode.notifyChange();
                 }
+                if( ImGui::MenuItem( "Diagnostics", nullptr, &m_ui.showDiagnostics ) )
+                {
+                    m_rendering.mode.notifyChange();
+                }
 
                 ImGui::Separator();
                 if( ImGui::MenuItem( "Reset Layout" ) )
@@ -295,6 +630,7 @@ namespace nfx::vista
                 bool isEventDriven = m_rendering.mode.mode() == RenderingMode::Mode::EventDriven;
                 bool isAdaptive = m_rendering.mode.mode() == RenderingMode::Mode::Adaptive;
                 bool isPolling = m_rendering.mode.mode() == RenderingMode::Mode::Polling;
+                bool isBudgeted = m_rendering.mode.mode() == RenderingMode::Mode::Budgeted;
 
                 if( ImGui::MenuItem( "Adaptive", nullptr, isAdaptive ) )
                 {
@@ -311,6 +647,20 @@ namespace nfx::vista
                     m_rendering.mode.setMode( RenderingMode::Mode::Polling );
                     m_rendering.mode.notifyChange();
                 }
+                if( ImGui::MenuItem( "Budgeted (Frame cap)", nullptr, isBudgeted ) )
+                {
+                    m_rendering.mode.setMode( RenderingMode::Mode::Budgeted );
+                    m_rendering.mode.notifyChange();
+                }
+                if( isBudgeted )
+                {
+                    int targetFps = m_rendering.mode.targetFps();
+                    ImGui::SetNextItemWidth( 120.0f );
+                    if( ImGui::SliderInt( "Target FPS", &targetFps, 5, 240 ) )
+                    {
+                        m_rendering.mode.setTargetFps( targetFps );
+                    }
+                }
 
                 ImGui::EndMenu();
             }
@@ -321,27 +671,114 @@ namespace nfx::vista
 
     void Application::renderPanels()
     {
+        // Version-dependent panels keep their dock slot but show a placeholder until the data is loaded
+        // use() also marks the version as most recently used and reloads it after an eviction
+        const bool versionReady = m_vis.store->use( m_vis.currentVersion ) != nullptr;
+
+        using Section = FrameProfiler::Section;
+        auto& profiler = m_rendering.profiler;
+
+        // Hidden panels (closed, collapsed or behind another dock tab) skip their model work, and so does
+        // the work that only serves them. Each panel catches up on its first visible frame.
+        bool gmodViewerVisible = false;
         if( m_ui.showGmodViewer )
         {
-            m_panels.gmodViewer->render( m_vis.currentVersion );
+            if( versionReady )
+            {
+                auto allocations = AllocationTracker::scope( AllocationTag::GmodViewer );
+                {
+                    auto timer = profiler.scope( Section::GmodViewer );
+                    gmodViewerVisible = m_panels.gmodViewer->render( m_vis.currentVersion );
+                }
+                if( gmodViewerVisible )
+                {
+                    // No search box on screen: no results to evaluate, and the query is kept for later
+                    auto timer = profiler.scope( Section::SearchOverlay );
+                    m_panels.gmodViewer->renderOverlay( m_vis.currentVersion );
+                }
+            }
+            else
+            {
+                renderLoadingPanel( "Gmod Viewer" );
+            }
         }
+        m_visibility.gmodViewer.update( gmodViewerVisible );
 
+        bool nodeDetailsVisible = false;
         if( m_ui.showNodeDetails )
         {
-            m_panels.nodeDetails->render();
+            auto timer = profiler.scope( Section::NodeDetails );
+            auto allocations = AllocationTracker::scope( AllocationTag::NodeDetails );
+            nodeDetailsVisible = m_panels.nodeDetails->render();
         }
+        m_visibility.nodeDetails.update( nodeDetailsVisible );
 
+        bool localIdBuilderVisible = false;
         if( m_ui.showLocalIdBuilder )
         {
-            m_panels.localIdBuilder->render( m_vis.currentVersion );
+            if( versionReady )
+            {
+                auto timer = profiler.scope( Section::LocalIdBuilder );
+                auto allocations = AllocationTracker::scope( AllocationTag::LocalIdBuilder );
+                localIdBuilderVisible = m_panels.localIdBuilder->render( m_vis.currentVersion );
+            }
+            else
+            {
+                renderLoadingPanel( "LocalId Builder" );
+            }
+        }
+        m_visibility.localIdBuilder.update( localIdBuilderVisible );
+
+        // Not version dependent: each LocalId names its own VIS version
+        if( m_ui.showLocalIdInspector )
+        {
+            auto timer = profiler.scope( Section::LocalIdInspector );
+            auto allocations = AllocationTracker::scope( AllocationTag::LocalIdInspector );
+            m_panels.localIdInspector->render();
         }
 
+        bool projectManagerVisible = false;
         if( m_ui.showProjectManager )
         {
-            m_panels.projectManager->render();
+            auto timer = profiler.scope( Section::ProjectManager );
+            auto allocations = AllocationTracker::scope( AllocationTag::ProjectManager );
+            projectManagerVisible = m_panels.projectManager->render();
+        }
+        m_visibility.projectManager.update( projectManagerVisible );
+
+        // Catch-up work (pending scroll to a revealed node, reparsed paths) was done while drawing the
+        // first visible frame; layout settles on the next one, which event-driven mode would not render
+        if( m_visibility.gmodViewer.becameVisible() || m_visibility.nodeDetails.becameVisible() ||
+            m_visibility.localIdBuilder.becameVisible() || m_visibility.projectManager.becameVisible() )
+        {
+            m_rendering.mode.notifyChange();
+        }
+
+        if( m_ui.showDiagnostics )
+        {
+            m_panels.diagnostics->render();
         }
     }
 
+    void Application::renderLoadingPanel( const char* name )
+    {
+        if( ImGui::Begin( name ) )
+        {
+            const char* version = VisVersions::toString( m_vis.currentVersion ).data();
+            if( m_vis.store->state( m_vis.currentVersion ) == VersionStore::State::Failed )
+            {
+                ImGui::PushStyleColor( ImGuiCol_Text, Theme::TextError );
+                ImGui::Text( "Failed to load VIS %s", version );
+                ImGui::PopStyleColor();
+            }
+            else
+            {
+                ImGui::TextDisabled( "Loading VIS %s...", version );
+            }
+        }
+        ImGui::End();
+    }
+
     void Application::renderStatusBar()
     {
         ImGuiViewport* viewport = ImGui::GetMainViewport();
@@ -370,7 +807,34 @@ namespace nfx::vista
             ImGui::TextDisabled( "|" );
             ImGui::SameLine();
 
-            ImGui::Text( "Nodes: %zu", m_status.nodeCount );
+            if( const auto* entry = m_vis.store->find( m_vis.currentVersion ) )
+            {
+                ImGui::Text( "Nodes: %zu", entry->nodeCount );
+            }
+            else
+            {
+                ImGui::TextDisabled( "Nodes: -" );
+            }
+
+            ImGui::SameLine();
+            ImGui::TextDisabled( "|" );
+            ImGui::SameLine();
+
+            renderResidencyStatus();
+
+            if( m_vis.store->isLoading() )
+            {
+                ImGui::SameLine();
+                ImGui::TextDisabled( "|" );
+                ImGui::SameLine();
+
+                const size_t settled = m_vis.store->settledCount();
+                const size_t total = m_vis.store->versionCount();
+                char progress[32];
+                snprintf( progress, sizeof( progress ), "Loading VIS %zu/%zu", settled, total );
+                ImGui::ProgressBar(
+                    static_cast<float>( settled ) / static_cast<float>( total ), ImVec2( 160.0f, 0.0f ), progress );
+            }
 
             ImGui::SameLine();
             ImGui::TextDisabled( "|" );
@@ -379,6 +843,19 @@ namespace nfx::vista
             // Rendering info
             ImGui::Text( "Mode: %s", m_rendering.mode.modeName() );
 
+            if( m_input.recorder )
+            {
+                ImGui::SameLine();
+                ImGui::PushStyleColor( ImGuiCol_Text, Theme::TextError );
+                ImGui::Text( "REC %zu frames", m_input.recorder->frameCount() );
+                ImGui::PopStyleColor();
+            }
+            else if( m_input.replay )
+            {
+                ImGui::SameLine();
+                ImGui::Text( "Replay %zu/%zu", m_input.replay->frameIndex(), m_input.replay->frameCount() );
+            }
+
             ImGui::SameLine();
             ImGui::TextDisabled( "|" );
             ImGui::SameLine();
@@ -391,7 +868,27 @@ namespace nfx::vista
 
             ImGui::Text( "OpenGL %s", m_status.glVersion.c_str() );
 
-            if( m_rendering.mode.mode() != RenderingMode::Mode::EventDriven )
+            if( m_rendering.mode.mode() == RenderingMode::Mode::Budgeted )
+            {
+                ImGui::SameLine();
+                ImGui::TextDisabled( "|" );
+                ImGui::SameLine();
+
+                const auto& pacing = m_rendering.mode.pacing();
+                const double achievedFps = pacing.intervalMs > 0.0 ? 1000.0 / pacing.intervalMs : 0.0;
+                const char* state = pacing.background ? "background" : ( pacing.boosting ? "active" : "idle" );
+                ImGui::Text( "FPS: %.1f/%d (%s)", achievedFps, m_rendering.mode.targetFps(), state );
+                if( ImGui::IsItemHovered() )
+                {
+                    ImGui::SetTooltip(
+                        "Frame interval: %.1f ms, jitter %.1f ms\n"
+                        "Full rate for a moment after input, slow wake-ups when idle,\n"
+                        "event-driven when unfocused or minimized",
+                        pacing.intervalMs,
+                        pacing.jitterMs );
+                }
+            }
+            else if( m_rendering.mode.mode() != RenderingMode::Mode::EventDriven )
             {
                 ImGui::SameLine();
                 ImGui::TextDisabled( "|" );
@@ -404,8 +901,231 @@ namespace nfx::vista
         ImGui::PopStyleVar( 3 );
     }
 
+    void Application::renderResidencyStatus()
+    {
+        constexpr double bytesPerMb = 1024.0 * 1024.0;
+        const auto residency = m_vis.store->residency();
+        const size_t budget = m_vis.store->memoryBudget();
+
+        if( budget > 0 )
+        {
+            ImGui::Text(
+                "Cache: %.1f/%.0f MB", static_cast<double>( residency.residentBytes ) / bytesPerMb,
+                static_cast<double>( budget ) / bytesPerMb );
+        }
+        else
+        {
+            ImGui::Text( "Cache: %.1f MB", static_cast<double>( residency.residentBytes ) / bytesPerMb );
+        }
+
+        ImGui::SameLine();
+        ImGui::TextDisabled(
+            "hit %zu  miss %zu  evict %zu", residency.hits, residency.misses, residency.evictions );
+
+        if( ImGui::IsItemHovered() )
+        {
+            ImGui::BeginTooltip();
+            ImGui::Text( "Resident versions: %zu/%zu", residency.residentVersions, m_vis.store->versionCount() );
+            ImGui::TextDisabled( "Hit: switched to a resident version" );
+            ImGui::TextDisabled( "Miss: switched to a version that had to be loaded" );
+            ImGui::TextDisabled( "Evict: least recently used version dropped to stay under budget" );
+            ImGui::EndTooltip();
+        }
+    }
+
+    void Application::prefetchAround( VisVersion version )
+    {
+        // Adjacent versions first, then the most recently used ones
+        auto versions = m_vis.instance->versions();
+        for( size_t i = 0; i < versions.size(); ++i )
+        {
+            if( versions[i] != version )
+            {
+                continue;
+            }
+            if( i + 1 < versions.size() )
+            {
+                m_vis.store->prefetch( versions[i + 1] );
+            }
+            if( i > 0 )
+            {
+                m_vis.store->prefetch( versions[i - 1] );
+            }
+            break;
+        }
+
+        for( const auto recent : m_vis.store->recentlyUsed( 3 ) )
+        {
+            m_vis.store->prefetch( recent );
+        }
+    }
+
+    void Application::writeStartupReport()
+    {
+        m_startup.reported = true;
+        const std::string report = m_startup.profiler.report( *m_vis.store );
+
+        if( m_options.startupReportPath.empty() )
+        {
+            std::cout << report << std::endl;
+        }
+        else
+        {
+            std::ofstream f( m_options.startupReportPath );
+            if( f )
+            {
+                f << report << "\n";
+            }
+            else
+            {
+                std::cerr << "Failed to write startup report to " << m_options.startupReportPath << "\n";
+            }
+        }
+
+        if( m_options.quitAfterStartup )
+        {
+            requestQuit();
+        }
+    }
+
+    void Application::waitForPendingLoads()
+    {
+        // Recorded and replayed frames must see the same data: never render while a version is loading
+        while( m_vis.store->hasPendingLoads() )
+        {
+            if( m_window.handle )
+            {
+                glfwWaitEventsTimeout( 0.05 );
+            }
+            else
+            {
+                std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+            }
+        }
+
+        // Nor while a panel snapshot (search, parse, validation) requested by the previous frame is in flight
+        m_workers->waitIdle();
+    }
+
+    void Application::finishReplay()
+    {
+        std::vector<double> sorted( m_input.frameMs.begin(), m_input.frameMs.end() );
+        std::sort( sorted.begin(), sorted.end() );
+        auto percentile = [&sorted]( double p ) {
+            if( sorted.empty() )
+            {
+                return 0.0;
+            }
+            const size_t rank = static_cast<size_t>( p * static_cast<double>( sorted.size() - 1 ) + 0.5 );
+            return sorted[std::min( rank, sorted.size() - 1 )];
+        };
+        const double totalMs = std::accumulate( sorted.begin(), sorted.end(), 0.0 );
+
+        nfx::json::Builder b( { .indent = 2 } );
+        b.writeStartObject();
+        b.write( "recording", m_options.replayInputPath );
+        b.write( "headless", m_options.headless );
+        b.write( "visVersion", m_input.replay->visVersion() );
+        b.write( "frames", m_input.replay->frameCount() );
+        b.write( "recordedSeconds", m_input.replay->recordedSeconds() );
+        b.write( "replayCpuMs", totalMs );
+
+        b.writeKey( "frameMs" );
+        b.writeStartObject();
+        b.write( "mean", sorted.empty() ? 0.0 : totalMs / static_cast<double>( sorted.size() ) );
+        b.write( "p50", percentile( 0.50 ) );
+        b.write( "p95", percentile( 0.95 ) );
+        b.write( "p99", percentile( 0.99 ) );
+        b.write( "max", sorted.empty() ? 0.0 : sorted.back() );
+        b.writeEndObject();
+
+        // Per-section percentiles cover the profiler history, i.e. the last frames of the replay
+        b.writeKey( "sections" );
+        b.writeStartArray();
+        for( size_t i = 0; i < static_cast<size_t>( FrameProfiler::Section::Count ); ++i )
+        {
+            const auto section = static_cast<FrameProfiler::Section>( i );
+            const auto stats = m_rendering.profiler.stats( section );
+            if( stats.samples == 0 )
+            {
+                continue;
+            }
+            b.writeStartObject();
+            b.write( "name", std::string( FrameProfiler::name( section ) ) );
+            b.write( "samples", stats.samples );
+            b.write( "p50", static_cast<double>( stats.p50 ) );
+            b.write( "p95", static_cast<double>( stats.p95 ) );
+            b.write( "p99", static_cast<double>( stats.p99 ) );
+            b.write( "max", static_cast<double>( stats.max ) );
+            b.writeEndObject();
+        }
+        b.writeEndArray();
+
+        b.writeKey( "perFrameMs" );
+        b.writeStartArray();
+        for( const float ms : m_input.frameMs )
+        {
+            b.write( static_cast<double>( ms ) );
+        }
+        b.writeEndArray();
+        b.writeEndObject();
+
+        if( m_options.replayReportPath.empty() )
+        {
+            std::cout << b.toString() << std::endl;
+        }
+        else
+        {
+            std::ofstream f( m_options.replayReportPath );
+            if( f )
+            {
+                f << b.toString() << "\n";
+            }
+            else
+            {
+                std::cerr << "Failed to write replay report to " << m_options.replayReportPath << "\n";
+            }
+        }
+
+        requestQuit();
+    }
+
+    bool Application::isRunning() const
+    {
+        return m_window.running && ( !m_window.handle || !glfwWindowShouldClose( m_window.handle ) );
+    }
+
+    void Application::requestQuit()
+    {
+        m_window.running = false;
+        if( m_window.handle )
+        {
+            glfwSetWindowShouldClose( m_window.handle, true );
+        }
+    }
+
     void Application::shutdown()
     {
+        {
+            // Join loaders before GLFW goes away: they post empty events on completion
+            m_workers.reset();
+        }
+
+        // Flushes the recording before the process exits
+        m_input.recorder.reset();
+
+        if( !m_options.tracePath.empty() )
+        {
+            Tracer::stop();
+            Tracer::write( m_options.tracePath );
+        }
+
+        if( !m_window.handle )
+        {
+            m_input.headless.reset();
+            return;
+        }
+
         {
             ImGui_ImplOpenGL3_Shutdown();
             ImGui_ImplGlfw_Shutdown();
@@ -420,7 +1140,7 @@ namespace nfx::vista
 
     void Application::calcFps()
     {
-        double currentTime = glfwGetTime();
+        double currentTime = RenderingMode::now();
         if( m_rendering.lastFrameTime > 0.0 )
         {
             double deltaTime = currentTime - m_rendering.lastFrameTime;
@@ -448,6 +1168,7 @@ namespace nfx::vista
 
         // Dock panels
         ImGui::DockBuilderDockWindow( "LocalId Builder", leftId );
+        ImGui::DockBuilderDockWindow( "LocalId Inspector", leftId );
         ImGui::DockBuilderDockWindow( "Project Manager", leftId );
         ImGui::DockBuilderDockWindow( "Gmod Viewer", rightTopId );
         ImGui::DockBuilderDockWindow( "Node Details", rightBottomId );
@@ -0,0 +1,92 @@
+#include "CodebookCache.h"
+
+#include <algorithm>
+#include <cctype>
+
+using namespace dnv::vista::sdk;
+
+namespace nfx::vista
+{
+    std::shared_ptr<const CodebookCache> CodebookCache::build( const Codebooks& codebooks )
+    {
+        // Private constructor: make_shared cannot reach it
+        std::shared_ptr<CodebookCache> cache( new CodebookCache() );
+
+        for( size_t i = 0; i < k_tagCodebooks.size(); ++i )
+        {
+            const auto& standardValues = codebooks[k_tagCodebooks[i]].standardValues();
+            auto& entry = cache->m_entries[i];
+
+            entry.sorted.reserve( standardValues.size() );
+            for( const auto& value : standardValues )
+                entry.sorted.push_back( value );
+            std::sort( entry.sorted.begin(), entry.sorted.end() );
+
+            entry.standard.reserve( entry.sorted.size() );
+            entry.standard.insert( entry.sorted.begin(), entry.sorted.end() );
+
+            entry.offsets.reserve( entry.sorted.size() + 1 );
+            for( const auto& value : entry.sorted )
+            {
+                entry.offsets.push_back( static_cast<uint32_t>( entry.corpus.size() ) );
+                for( char c : value )
+                {
+                    entry.corpus += static_cast<char>( std::tolower( static_cast<unsigned char>( c ) ) );
+                }
+                entry.corpus += '\n'; // Never in a lowercase query taken from a single-line input
+            }
+            entry.offsets.push_back( static_cast<uint32_t>( entry.corpus.size() ) );
+        }
+
+        return cache;
+    }
+
+    const std::vector<std::string>& CodebookCache::sortedValues( CodebookName codebook ) const
+    {
+        static const std::vector<std::string> s_empty;
+        const size_t i = slot( codebook );
+        return i < m_entries.size() ? m_entries[i].sorted : s_empty;
+    }
+
+    bool CodebookCache::isStandardValue( CodebookName codebook, std::string_view value ) const
+    {
+        const size_t i = slot( codebook );
+        return i < m_entries.size() && m_entries[i].standard.find( value ) != m_entries[i].standard.end();
+    }
+
+    void CodebookCache::filter(
+        CodebookName codebook, std::string_view lowerQuery, std::vector<uint32_t>& matches ) const
+    {
+        matches.clear();
+        const size_t i = slot( codebook );
+        if( i >= m_entries.size() || lowerQuery.empty() )
+        {
+            return;
+        }
+
+        const auto& entry = m_entries[i];
+        const std::string_view corpus = entry.corpus;
+
+        // Prefix matches are appended in place, the others collected behind them
+        thread_local std::vector<uint32_t> s_infix;
+        s_infix.clear();
+
+        size_t pos = corpus.find( lowerQuery );
+        while( pos != std::string_view::npos )
+        {
+            const auto next = std::upper_bound( entry.offsets.begin(), entry.offsets.end(), pos );
+            const auto index = static_cast<uint32_t>( next - entry.offsets.begin() - 1 );
+
+            ( entry.offsets[index] == pos ? matches : s_infix ).push_back( index );
+            pos = corpus.find( lowerQuery, *next );
+        }
+
+        matches.insert( matches.end(), s_infix.begin(), s_infix.end() );
+    }
+
+    size_t CodebookCache::slot( CodebookName codebook )
+    {
+        return static_cast<size_t>(
+            std::find( k_tagCodebooks.begin(), k_tagCodebooks.end(), codebook ) - k_tagCodebooks.begin() );
+    }
+} // namespace nfx::vista
@@ -0,0 +1,56 @@
+#include "DrawDataHash.h"
+#include "Hash.h"
+
+#include <imgui.h>
+
+namespace nfx::vista
+{
+    std::optional<uint64_t> hashDrawData( const ImDrawData& drawData, int framebufferWidth, int framebufferHeight )
+    {
+#if IMGUI_VERSION_NUM >= 19200
+        // Texture creation/updates are carried out by the renderer backend while rendering
+        if( drawData.Textures )
+        {
+            for( const ImTextureData* tex : *drawData.Textures )
+            {
+                if( tex->Status != ImTextureStatus_OK )
+                {
+                    return std::nullopt;
+                }
+            }
+        }
+#endif
+
+        uint64_t h = hash::k_seed;
+        h = hash::mix(
+            h, static_cast<uint64_t>( framebufferWidth ) << 32 | static_cast<uint32_t>( framebufferHeight ) );
+        h = hash::value( h, drawData.DisplayPos );
+        h = hash::value( h, drawData.DisplaySize );
+        h = hash::value( h, drawData.FramebufferScale );
+        h = hash::mix( h, static_cast<uint64_t>( drawData.CmdListsCount ) );
+
+        for( const ImDrawList* list : drawData.CmdLists )
+        {
+            h = hash::bytes(
+                h, list->VtxBuffer.Data, static_cast<size_t>( list->VtxBuffer.Size ) * sizeof( ImDrawVert ) );
+            h = hash::bytes(
+                h, list->IdxBuffer.Data, static_cast<size_t>( list->IdxBuffer.Size ) * sizeof( ImDrawIdx ) );
+
+            for( const ImDrawCmd& cmd : list->CmdBuffer )
+            {
+                // Callbacks may draw anything (e.g. reset render state), never assume they are idempotent
+                if( cmd.UserCallback != nullptr )
+                {
+                    return std::nullopt;
+                }
+
+                h = hash::value( h, cmd.ClipRect );
+                h = hash::value( h, cmd.GetTexID() );
+                h = hash::mix( h, static_cast<uint64_t>( cmd.VtxOffset ) << 32 | cmd.IdxOffset );
+                h = hash::mix( h, static_cast<uint64_t>( cmd.ElemCount ) );
+            }
+        }
+
+        return h;
+    }
+} // namespace nfx::vista
@@ -0,0 +1,141 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+namespace nfx::vista
+{
+    namespace
+    {
+        constexpr size_t k_initialCapacity = 64 * 1024;
+
+        class Arena final : public std::pmr::memory_resource
+        {
+        public:
+            void reset()
+            {
+                m_peak = std::max( m_peak, m_used );
+
+                if( m_chunks.size() > 1 )
+                {
+                    // The frame overflowed: one chunk large enough for all of it next time
+                    size_t total = 0;
+                    for( const auto& chunk : m_chunks )
+                    {
+                        total += chunk.size;
+                    }
+                    m_chunks.clear();
+                    addChunk( total );
+                }
+
+                m_offset = 0;
+                m_used = 0;
+            }
+
+            size_t used() const
+            {
+                return m_used;
+            }
+
+            size_t peak() const
+            {
+                return std::max( m_peak, m_used );
+            }
+
+            size_t capacity() const
+            {
+                size_t total = 0;
+                for( const auto& chunk : m_chunks )
+                {
+                    total += chunk.size;
+                }
+                return total;
+            }
+
+        private:
+            struct Chunk
+            {
+                std::unique_ptr<std::byte[]> data;
+                size_t size;
+            };
+
+            void addChunk( size_t size )
+            {
+                m_chunks.push_back( Chunk{ std::make_unique<std::byte[]>( size ), size } );
+                m_offset = 0;
+            }
+
+            void* do_allocate( size_t bytes, size_t alignment ) override
+            {
+                if( m_chunks.empty() )
+                {
+                    addChunk( std::max( k_initialCapacity, bytes + alignment ) );
+                }
+
+                auto* base = m_chunks.back().data.get();
+                auto address = reinterpret_cast<uintptr_t>( base ) + m_offset;
+                size_t padding = ( alignment - address % alignment ) % alignment;
+
+                if( m_offset + padding + bytes > m_chunks.back().size )
+                {
+                    // Earlier chunks stay alive until reset(): their allocations are still in use
+                    addChunk( std::max( m_chunks.back().size * 2, bytes + alignment ) );
+                    base = m_chunks.back().data.get();
+                    address = reinterpret_cast<uintptr_t>( base );
+                    padding = ( alignment - address % alignment ) % alignment;
+                }
+
+                void* result = base + m_offset + padding;
+                m_offset += padding + bytes;
+                m_used += bytes;
+                return result;
+            }
+
+            void do_deallocate( void*, size_t, size_t ) override
+            {
+            }
+
+            bool do_is_equal( const std::pmr::memory_resource& other ) const noexcept override
+            {
+                return this == &other;
+            }
+
+            std::vector<Chunk> m_chunks;
+            size_t m_offset = 0; ///< Into the last chunk
+            size_t m_used = 0;
+            size_t m_peak = 0;
+        };
+
+        Arena& arena()
+        {
+            static Arena a;
+            return a;
+        }
+    } // namespace
+
+    std::pmr::memory_resource* FrameArena::resource()
+    {
+        return &arena();
+    }
+
+    void FrameArena::reset()
+    {
+        arena().reset();
+    }
+
+    size_t FrameArena::used()
+    {
+        return arena().used();
+    }
+
+    size_t FrameArena::peak()
+    {
+        return arena().peak();
+    }
+
+    size_t FrameArena::capacity()
+    {
+        return arena().capacity();
+    }
+} // namespace nfx::vista
@@ -0,0 +1,635 @@
+#include "GmodIndex.h"
+#include "MappedFile.h"
+#include "ProjectSerializer.h"
+#include "diagnostics/Tracer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+// Set by CMake from the fetched vista-sdk revision; snapshots written by another SDK build are ignored,
+// and none are written when the revision is unknown
+#ifndef VISTA_SDK_BUILD_HASH
+#    define VISTA_SDK_BUILD_HASH ""
+#endif
+
+using namespace dnv::vista::sdk;
+
+namespace nfx::vista
+{
+    namespace
+    {
+        constexpr char k_magic[8] = { 'N', 'F', 'X', 'G', 'I', 'D', 'X', '\0' };
+        constexpr uint32_t k_formatVersion = 1;
+        constexpr uint32_t k_flagStructural = 1u << 0;
+        constexpr char k_fieldSeparator = '\x1f';
+        constexpr auto k_snapshotMaxAge = std::chrono::hours( 24 * 30 ); ///< Unused this long: removed
+
+        uint64_t fnv1a( std::string_view text )
+        {
+            uint64_t hash = 14695981039346656037ull;
+            for( char c : text )
+            {
+                hash ^= static_cast<unsigned char>( c );
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        uint64_t sdkBuildHash()
+        {
+            static const uint64_t hash = fnv1a( VISTA_SDK_BUILD_HASH );
+            return hash;
+        }
+
+        size_t align8( size_t offset )
+        {
+            return ( offset + 7 ) & ~size_t{ 7 };
+        }
+
+        void appendLower( std::string& out, std::string_view text )
+        {
+            for( char c : text )
+            {
+                out += static_cast<char>( std::tolower( static_cast<unsigned char>( c ) ) );
+            }
+        }
+
+        bool isProductType( const GmodNode& node )
+        {
+            return node.metadata().category() == "PRODUCT" && node.metadata().type() == "TYPE";
+        }
+
+        bool isFunctionSelection( const GmodNode& node )
+        {
+            std::string_view category = node.metadata().category();
+            return node.metadata().type() == "SELECTION" &&
+                   ( category == "PRODUCT FUNCTION" || category == "ASSET FUNCTION" );
+        }
+
+        // Natural sort key: numeric prefix of the code ("411" < "1000")
+        int numericPrefix( std::string_view code )
+        {
+            int num = 0;
+            for( char c : code )
+            {
+                if( c < '0' || c > '9' )
+                {
+                    break;
+                }
+                num = num * 10 + ( c - '0' );
+            }
+            return num;
+        }
+
+        void copyVersion( char ( &dest )[16], VisVersion version )
+        {
+            std::memset( dest, 0, sizeof( dest ) );
+            std::string_view text = VisVersions::toString( version );
+            std::memcpy( dest, text.data(), std::min( text.size(), sizeof( dest ) - 1 ) );
+        }
+
+        bool fitsIn( uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t totalSize )
+        {
+            return offset <= totalSize && count <= ( totalSize - offset ) / elementSize;
+        }
+    } // namespace
+
+    struct GmodIndex::Header
+    {
+        char magic[8];
+        uint32_t formatVersion;
+        uint32_t nodeCount;
+        uint64_t sdkHash;
+        char visVersion[16];
+        uint32_t rootChildCount;
+        uint32_t displayChildCount;
+        uint64_t nodesOffset;
+        uint64_t displayOffset;
+        uint64_t rootOffset;
+        uint64_t codeOrderOffset;
+        uint64_t stringsOffset;
+        uint64_t totalSize;
+    };
+
+    struct GmodIndex::NodeRecord
+    {
+        uint32_t codeOffset;
+        uint32_t codeLength;
+        uint32_t searchOffset;
+        uint32_t searchLength;
+        uint32_t parent;
+        uint32_t depth;
+        uint32_t descendants;
+        uint32_t displayBegin;
+        uint32_t displayCount;
+        uint32_t flags;
+    };
+
+    GmodIndex::~GmodIndex() = default;
+
+    std::unique_ptr<GmodIndex> GmodIndex::build( VisVersion version, const Gmod& gmod )
+    {
+        auto trace = Tracer::scope( "GmodIndex::build", "load" );
+        std::unique_ptr<GmodIndex> index( new GmodIndex() );
+        auto& nodes = index->m_nodes;
+
+        std::unordered_map<const GmodNode*, uint32_t> indexOfNode;
+        for( const auto& [code, node] : gmod )
+        {
+            indexOfNode.emplace( &node, static_cast<uint32_t>( nodes.size() ) );
+            nodes.push_back( &node );
+        }
+
+        auto lookup = [&]( const GmodNode* node ) -> uint32_t {
+            auto it = indexOfNode.find( node );
+            return it == indexOfNode.end() ? k_none : it->second;
+        };
+
+        const uint32_t count = static_cast<uint32_t>( nodes.size() );
+        std::vector<NodeRecord> records( count );
+        std::vector<DisplayChild> display;
+        std::string strings;
+
+        for( uint32_t i = 0; i < count; ++i )
+        {
+            const GmodNode& node = *nodes[i];
+            auto& rec = records[i];
+
+            rec.codeOffset = static_cast<uint32_t>( strings.size() );
+            rec.codeLength = static_cast<uint32_t>( node.code().size() );
+            strings += node.code();
+
+            rec.searchOffset = static_cast<uint32_t>( strings.size() );
+            appendLower( strings, node.code() );
+            strings += k_fieldSeparator;
+            appendLower( strings, node.metadata().name() );
+            if( node.metadata().commonName().has_value() )
+            {
+                strings += k_fieldSeparator;
+                appendLower( strings, node.metadata().commonName().value() );
+            }
+            rec.searchLength = static_cast<uint32_t>( strings.size() ) - rec.searchOffset;
+
+            rec.parent = node.parents().isEmpty() ? k_none : lookup( node.parents()[0] );
+
+            std::string_view code = node.code();
+            rec.flags = ( !code.empty() && ( code.back() == 'i' || code.back() == 's' ) ) ? k_flagStructural : 0;
+
+            // Display children, mirroring the tree rules (Vindøy 2008, sections 2.2 and 2.3):
+            // the node's Product Type is shown as a badge and its children are promoted, selections
+            // are removed and their children promoted with this node as badge.
+            rec.displayBegin = static_cast<uint32_t>( display.size() );
+
+            auto add = [&]( const GmodNode* child, uint32_t badge ) {
+                const uint32_t childIndex = lookup( child );
+                if( childIndex != k_none )
+                {
+                    display.push_back( { childIndex, badge } );
+                }
+            };
+
+            const auto productType = node.productType();
+            for( const auto* child : node.children() )
+            {
+                if( productType.has_value() && child == productType.value() )
+                {
+                    for( const auto* grandchild : child->children() )
+                    {
+                        if( grandchild->isProductSelection() )
+                        {
+                            for( const auto* greatGrandchild : grandchild->children() )
+                            {
+                                add( greatGrandchild, i );
+                            }
+                        }
+                        else if( isProductType( *grandchild ) )
+                        {
+                            add( grandchild, i );
+                        }
+                        else
+                        {
+                            add( grandchild, k_none );
+                        }
+                    }
+                    continue;
+                }
+
+                if( child->isProductSelection() || isFunctionSelection( *child ) )
+                {
+                    for( const auto* grandchild : child->children() )
+                    {
+                        add( grandchild, i );
+                    }
+                }
+                else if( isProductType( *child ) )
+                {
+                    // A Product Type under a Product Type propagates the badge it was given
+                    add( child, isProductType( node ) ? k_inherit : i );
+                }
+                else
+                {
+                    add( child, k_none );
+                }
+            }
+
+            rec.displayCount = static_cast<uint32_t>( display.size() ) - rec.displayBegin;
+        }
+
+        // Subtree metrics: depth along the first-parent chain, descendants counted over all children
+        std::vector<uint32_t> depthMemo( count, k_none );
+        auto computeDepth = [&]( auto& self, uint32_t i ) -> uint32_t {
+            if( depthMemo[i] == k_none )
+            {
+                const uint32_t parent = records[i].parent;
+                depthMemo[i] = parent == k_none ? 0 : self( self, parent ) + 1;
+            }
+            return depthMemo[i];
+        };
+
+        std::vector<uint32_t> descendantMemo( count, k_none );
+        auto computeDescendants = [&]( auto& self, uint32_t i ) -> uint32_t {
+            if( descendantMemo[i] == k_none )
+            {
+                uint64_t total = 0;
+                for( const auto* child : nodes[i]->children() )
+                {
+                    const uint32_t c = lookup( child );
+                    if( c != k_none )
+                    {
+                        total += 1 + self( self, c );
+                    }
+                }
+                descendantMemo[i] = static_cast<uint32_t>( std::min<uint64_t>( total, k_none - 1 ) );
+            }
+            return descendantMemo[i];
+        };
+
+        for( uint32_t i = 0; i < count; ++i )
+        {
+            records[i].depth = computeDepth( computeDepth, i );
+            records[i].descendants = computeDescendants( computeDescendants, i );
+        }
+
+        std::vector<uint32_t> roots;
+        for( const auto* child : gmod.rootNode().children() )
+        {
+            const uint32_t c = lookup( child );
+            if( c != k_none )
+            {
+                roots.push_back( c );
+            }
+        }
+        std::sort( roots.begin(), roots.end(), [&]( uint32_t a, uint32_t b ) {
+            const int numA = numericPrefix( nodes[a]->code() );
+            const int numB = numericPrefix( nodes[b]->code() );
+            if( numA != numB )
+            {
+                return numA < numB;
+            }
+            return nodes[a]->code() < nodes[b]->code();
+        } );
+
+        std::vector<uint32_t> codeOrder( count );
+        for( uint32_t i = 0; i < count; ++i )
+        {
+            codeOrder[i] = i;
+        }
+        std::sort( codeOrder.begin(), codeOrder.end(), [&]( uint32_t a, uint32_t b ) {
+            return nodes[a]->code() < nodes[b]->code();
+        } );
+
+        // Lay out all tables in one buffer
+        Header header{};
+        std::memcpy( header.magic, k_magic, sizeof( k_magic ) );
+        header.formatVersion = k_formatVersion;
+        header.nodeCount = count;
+        header.sdkHash = sdkBuildHash();
+        copyVersion( header.visVersion, version );
+        header.rootChildCount = static_cast<uint32_t>( roots.size() );
+        header.displayChildCount = static_cast<uint32_t>( display.size() );
+
+        size_t offset = align8( sizeof( Header ) );
+        header.nodesOffset = offset;
+        offset = align8( offset + records.size() * sizeof( NodeRecord ) );
+        header.displayOffset = offset;
+        offset = align8( offset + display.size() * sizeof( DisplayChild ) );
+        header.rootOffset = offset;
+        offset = align8( offset + roots.size() * sizeof( uint32_t ) );
+        header.codeOrderOffset = offset;
+        offset = align8( offset + codeOrder.size() * sizeof( uint32_t ) );
+        header.stringsOffset = offset;
+        offset += strings.size();
+        header.totalSize = offset;
+
+        auto& buffer = index->m_buffer;
+        buffer.resize( offset );
+        auto copy = [&]( uint64_t at, const void* src, size_t bytes ) {
+            if( bytes > 0 )
+            {
+                std::memcpy( buffer.data() + at, src, bytes );
+            }
+        };
+        copy( 0, &header, sizeof( Header ) );
+        copy( header.nodesOffset, records.data(), records.size() * sizeof( NodeRecord ) );
+        copy( header.displayOffset, display.data(), display.size() * sizeof( DisplayChild ) );
+        copy( header.rootOffset, roots.data(), roots.size() * sizeof( uint32_t ) );
+        copy( header.codeOrderOffset, codeOrder.data(), codeOrder.size() * sizeof( uint32_t ) );
+        copy( header.stringsOffset, strings.data(), strings.size() );
+
+        index->m_data = buffer.data();
+        return index;
+    }
+
+    std::unique_ptr<GmodIndex> GmodIndex::loadSnapshot(
+        const std::filesystem::path& path, VisVersion version, const Gmod& gmod )
+    {
+        auto trace = Tracer::scope( "GmodIndex::loadSnapshot", "io" );
+        auto mapping = MappedFile::open( path );
+        if( !mapping || mapping->size() < sizeof( Header ) )
+        {
+            return nullptr;
+        }
+
+        const auto& header = *reinterpret_cast<const Header*>( mapping->data() );
+        char expectedVersion[16];
+        copyVersion( expectedVersion, version );
+
+        if( std::memcmp( header.magic, k_magic, sizeof( k_magic ) ) != 0 ||
+            header.formatVersion != k_formatVersion || header.sdkHash != sdkBuildHash() ||
+            std::memcmp( header.visVersion, expectedVersion, sizeof( expectedVersion ) ) != 0 ||
+            header.totalSize != mapping->size() )
+        {
+            return nullptr;
+        }
+
+        // Reject truncated or corrupted files before any table is dereferenced
+        const uint64_t total = header.totalSize;
+        if( !fitsIn( header.nodesOffset, header.nodeCount, sizeof( NodeRecord ), total ) ||
+            !fitsIn( header.displayOffset, header.displayChildCount, sizeof( DisplayChild ), total ) ||
+            !fitsIn( header.rootOffset, header.rootChildCount, sizeof( uint32_t ), total ) ||
+            !fitsIn( header.codeOrderOffset, header.nodeCount, sizeof( uint32_t ), total ) ||
+            header.stringsOffset > total )
+        {
+            return nullptr;
+        }
+
+        // Tables are read in place: they must keep the alignment build() gave them
+        const uint64_t offsetBits = header.nodesOffset | header.displayOffset | header.rootOffset |
+                                    header.codeOrderOffset | header.stringsOffset;
+        if( offsetBits % 8 != 0 )
+        {
+            return nullptr;
+        }
+
+        std::unique_ptr<GmodIndex> index( new GmodIndex() );
+        index->m_data = mapping->data();
+        index->m_mapping = std::move( mapping );
+
+        if( !index->resolveNodes( gmod ) )
+        {
+            return nullptr;
+        }
+
+        // Age counts from the last use: another build's cleanup keeps a snapshot this build still reads
+        std::error_code ec;
+        std::filesystem::last_write_time( path, std::filesystem::file_time_type::clock::now(), ec );
+
+        return index;
+    }
+
+    bool GmodIndex::resolveNodes( const Gmod& gmod )
+    {
+        const uint32_t count = header().nodeCount;
+        const uint64_t stringBytes = header().totalSize - header().stringsOffset;
+        const char* strings = reinterpret_cast<const char*>( m_data + header().stringsOffset );
+
+        m_nodes.clear();
+        m_nodes.reserve( count );
+
+        // Same SDK build means same iteration order; verify it code by code anyway
+        for( const auto& [code, node] : gmod )
+        {
+            const uint32_t i = static_cast<uint32_t>( m_nodes.size() );
+            if( i >= count )
+            {
+                return false;
+            }
+
+            const auto& rec = record( i );
+            if( uint64_t{ rec.codeOffset } + rec.codeLength > stringBytes ||
+                uint64_t{ rec.searchOffset } + rec.searchLength > stringBytes ||
+                uint64_t{ rec.displayBegin } + rec.displayCount > header().displayChildCount ||
+                std::string_view( strings + rec.codeOffset, rec.codeLength ) != node.code() )
+            {
+                return false;
+            }
+
+            m_nodes.push_back( &node );
+        }
+
+        if( m_nodes.size() != count )
+        {
+            return false;
+        }
+
+        // Every node index stored in the tables is used to index m_nodes: check them all once here
+        auto isNode = [count]( uint32_t i ) { return i < count; };
+
+        for( uint32_t i = 0; i < count; ++i )
+        {
+            const uint32_t parent = record( i ).parent;
+            if( parent != k_none && !isNode( parent ) )
+            {
+                return false;
+            }
+        }
+
+        const auto* display = reinterpret_cast<const DisplayChild*>( m_data + header().displayOffset );
+        for( const auto& child : std::span( display, header().displayChildCount ) )
+        {
+            const bool validBadge = child.badge == k_none || child.badge == k_inherit || isNode( child.badge );
+            if( !isNode( child.node ) || !validBadge )
+            {
+                return false;
+            }
+        }
+
+        if( !std::all_of( rootChildren().begin(), rootChildren().end(), isNode ) )
+        {
+            return false;
+        }
+
+        // indexOf() binary-searches codeOrder: it must hold each node exactly once
+        const auto* codeOrder = reinterpret_cast<const uint32_t*>( m_data + header().codeOrderOffset );
+        std::vector<bool> seen( count, false );
+        for( const uint32_t i : std::span( codeOrder, count ) )
+        {
+            if( !isNode( i ) || seen[i] )
+            {
+                return false;
+            }
+            seen[i] = true;
+        }
+
+        return true;
+    }
+
+    bool GmodIndex::saveSnapshot( const std::filesystem::path& path ) const
+    {
+        auto trace = Tracer::scope( "GmodIndex::saveSnapshot", "io" );
+        std::error_code ec;
+        std::filesystem::create_directories( path.parent_path(), ec );
+
+        auto tempPath = path;
+        tempPath += ".tmp";
+
+        {
+            std::ofstream f( tempPath, std::ios::binary | std::ios::trunc );
+            if( !f )
+            {
+                return false;
+            }
+            f.write( reinterpret_cast<const char*>( m_data ), static_cast<std::streamsize>( header().totalSize ) );
+            if( !f.good() )
+            {
+                return false;
+            }
+        }
+
+        std::filesystem::rename( tempPath, path, ec );
+        if( ec )
+        {
+            std::filesystem::remove( tempPath, ec );
+            return false;
+        }
+        return true;
+    }
+
+    std::filesystem::path GmodIndex::snapshotPath( VisVersion version )
+    {
+        if( std::string_view( VISTA_SDK_BUILD_HASH ).empty() )
+        {
+            return {};
+        }
+
+        char hash[17];
+        snprintf( hash, sizeof( hash ), "%016llx", static_cast<unsigned long long>( sdkBuildHash() ) );
+
+        std::string name = "gmod-";
+        name += VisVersions::toString( version );
+        name += '-';
+        name += hash;
+        name += ".idx";
+
+        return ProjectSerializer::defaultDir() / "cache" / name;
+    }
+
+    void GmodIndex::removeStaleSnapshots( VisVersion version )
+    {
+        const auto current = snapshotPath( version );
+        if( current.empty() )
+        {
+            return;
+        }
+
+        std::string prefix = "gmod-";
+        prefix += VisVersions::toString( version );
+        prefix += '-';
+
+        // Other builds sharing the directory may still use theirs: only long unused files go
+        const auto cutoff = std::filesystem::file_time_type::clock::now() - k_snapshotMaxAge;
+        std::error_code ec;
+        for( const auto& entry : std::filesystem::directory_iterator( current.parent_path(), ec ) )
+        {
+            const auto name = entry.path().filename().string();
+            if( !name.starts_with( prefix ) || entry.path() == current )
+            {
+                continue;
+            }
+            std::error_code timeEc;
+            const auto written = entry.last_write_time( timeEc );
+            if( !timeEc && written < cutoff )
+            {
+                std::error_code removeEc;
+                std::filesystem::remove( entry.path(), removeEc );
+            }
+        }
+    }
+
+    std::optional<uint32_t> GmodIndex::indexOf( std::string_view code ) const
+    {
+        const auto* order = reinterpret_cast<const uint32_t*>( m_data + header().codeOrderOffset );
+        const auto* end = order + header().nodeCount;
+
+        auto it = std::lower_bound(
+            order, end, code, [this]( uint32_t i, std::string_view value ) { return node( i ).code() < value; } );
+
+        if( it == end || node( *it ).code() != code )
+        {
+            return std::nullopt;
+        }
+        return *it;
+    }
+
+    uint32_t GmodIndex::parent( uint32_t index ) const
+    {
+        return record( index ).parent;
+    }
+
+    uint32_t GmodIndex::depth( uint32_t index ) const
+    {
+        return record( index ).depth;
+    }
+
+    uint32_t GmodIndex::descendantCount( uint32_t index ) const
+    {
+        return record( index ).descendants;
+    }
+
+    bool GmodIndex::isStructural( uint32_t index ) const
+    {
+        return ( record( index ).flags & k_flagStructural ) != 0;
+    }
+
+    std::string_view GmodIndex::searchText( uint32_t index ) const
+    {
+        const auto& rec = record( index );
+        const char* strings = reinterpret_cast<const char*>( m_data + header().stringsOffset );
+        return { strings + rec.searchOffset, rec.searchLength };
+    }
+
+    std::span<const GmodIndex::DisplayChild> GmodIndex::displayChildren( uint32_t index ) const
+    {
+        const auto& rec = record( index );
+        const auto* table = reinterpret_cast<const DisplayChild*>( m_data + header().displayOffset );
+        return { table + rec.displayBegin, rec.displayCount };
+    }
+
+    std::span<const uint32_t> GmodIndex::rootChildren() const
+    {
+        const auto* table = reinterpret_cast<const uint32_t*>( m_data + header().rootOffset );
+        return { table, header().rootChildCount };
+    }
+
+    size_t GmodIndex::byteSize() const
+    {
+        return header().totalSize + m_nodes.capacity() * sizeof( const GmodNode* );
+    }
+
+    const GmodIndex::Header& GmodIndex::header() const
+    {
+        return *reinterpret_cast<const Header*>( m_data );
+    }
+
+    const GmodIndex::NodeRecord& GmodIndex::record( uint32_t index ) const
+    {
+        const auto* table = reinterpret_cast<const NodeRecord*>( m_data + header().nodesOffset );
+        return table[index];
+    }
+} // namespace nfx::vista
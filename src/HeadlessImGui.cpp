@@ -0,0 +1,72 @@
+#include "HeadlessImGui.h"
+#include "config/Theme.h"
+#include "diagnostics/AllocationTracker.h"
+
+#include <cstdint>
+
+namespace nfx::vista
+{
+    HeadlessImGui::HeadlessImGui( ImVec2 displaySize )
+    {
+        IMGUI_CHECKVERSION();
+        ImGui::SetAllocatorFunctions( &AllocationTracker::imguiAlloc, &AllocationTracker::imguiFree );
+        m_context = ImGui::CreateContext();
+
+        ImGuiIO& io = ImGui::GetIO();
+        io.IniFilename = nullptr;
+        io.LogFilename = nullptr;
+        io.DisplaySize = displaySize;
+        io.DeltaTime = 1.0f / 60.0f;
+        io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+
+        ImGui::StyleColorsDark();
+        Theme::apply( ImGui::GetStyle() );
+
+#if IMGUI_VERSION_NUM >= 19200
+        // Texture requests are acknowledged in render()
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+#else
+        unsigned char* pixels = nullptr;
+        int width = 0;
+        int height = 0;
+        io.Fonts->GetTexDataAsRGBA32( &pixels, &width, &height );
+        io.Fonts->SetTexID( static_cast<ImTextureID>( 1 ) );
+#endif
+    }
+
+    HeadlessImGui::~HeadlessImGui()
+    {
+        ImGui::DestroyContext( m_context );
+    }
+
+    void HeadlessImGui::newFrame()
+    {
+        ImGui::NewFrame();
+    }
+
+    void HeadlessImGui::render()
+    {
+        ImGui::Render();
+
+#if IMGUI_VERSION_NUM >= 19200
+        // Stand-in for a renderer backend: pretend every texture request succeeded
+        for( ImTextureData* tex : ImGui::GetPlatformIO().Textures )
+        {
+            if( tex->Status == ImTextureStatus_WantCreate )
+            {
+                tex->SetTexID( static_cast<ImTextureID>( static_cast<uint64_t>( tex->UniqueID ) + 1 ) );
+                tex->SetStatus( ImTextureStatus_OK );
+            }
+            else if( tex->Status == ImTextureStatus_WantUpdates )
+            {
+                tex->SetStatus( ImTextureStatus_OK );
+            }
+            else if( tex->Status == ImTextureStatus_WantDestroy )
+            {
+                tex->SetTexID( ImTextureID_Invalid );
+                tex->SetStatus( ImTextureStatus_Destroyed );
+            }
+        }
+#endif
+    }
+} // namespace nfx::vista
@@ -0,0 +1,168 @@
+#include "LaunchOptions.h"
+
+#include <charconv>
+#include <iostream>
+#include <string_view>
+
+namespace nfx::vista
+{
+    namespace
+    {
+        std::optional<size_t> parseSize( std::string_view text )
+        {
+            size_t value = 0;
+            const auto [end, ec] = std::from_chars( text.data(), text.data() + text.size(), value );
+            if( ec != std::errc{} || end != text.data() + text.size() )
+            {
+                return std::nullopt;
+            }
+            return value;
+        }
+    } // namespace
+
+    std::optional<LaunchOptions> LaunchOptions::parse( int argc, char** argv )
+    {
+        LaunchOptions options;
+
+        for( int i = 1; i < argc; ++i )
+        {
+            const std::string_view arg = argv[i];
+
+            if( arg == "--help" || arg == "-h" )
+            {
+                options.showHelp = true;
+            }
+            else if( arg.starts_with( "--memory-budget=" ) )
+            {
+                const auto mb = parseSize( arg.substr( std::string_view{ "--memory-budget=" }.size() ) );
+                if( !mb.has_value() )
+                {
+                    std::cerr << "Invalid memory budget: " << arg << "\n";
+                    return std::nullopt;
+                }
+                options.memoryBudgetBytes = mb.value() * 1024 * 1024;
+            }
+            else if( arg.starts_with( "--rendering-mode=" ) )
+            {
+                const auto name = arg.substr( std::string_view{ "--rendering-mode=" }.size() );
+                if( name == "event" )
+                {
+                    options.renderingMode = RenderingMode::Mode::EventDriven;
+                }
+                else if( name == "adaptive" )
+                {
+                    options.renderingMode = RenderingMode::Mode::Adaptive;
+                }
+                else if( name == "polling" )
+                {
+                    options.renderingMode = RenderingMode::Mode::Polling;
+                }
+                else if( name == "budgeted" )
+                {
+                    options.renderingMode = RenderingMode::Mode::Budgeted;
+                }
+                else
+                {
+                    std::cerr << "Invalid rendering mode: " << arg << "\n";
+                    return std::nullopt;
+                }
+            }
+            else if( arg.starts_with( "--target-fps=" ) )
+            {
+                const auto fps = parseSize( arg.substr( std::string_view{ "--target-fps=" }.size() ) );
+                if( !fps.has_value() || fps.value() == 0 || fps.value() > 1000 )
+                {
+                    std::cerr << "Invalid target frame rate: " << arg << "\n";
+                    return std::nullopt;
+                }
+                options.targetFps = static_cast<int>( fps.value() );
+            }
+            else if( arg == "--startup-report" )
+            {
+                options.startupReport = true;
+            }
+            else if( arg.starts_with( "--startup-report=" ) )
+            {
+                options.startupReport = true;
+                options.startupReportPath = arg.substr( std::string_view{ "--startup-report=" }.size() );
+            }
+            else if( arg == "--quit-after-startup" )
+            {
+                options.quitAfterStartup = true;
+            }
+            else if( arg.starts_with( "--record-input=" ) )
+            {
+                options.recordInputPath = arg.substr( std::string_view{ "--record-input=" }.size() );
+            }
+            else if( arg.starts_with( "--replay-input=" ) )
+            {
+                options.replayInputPath = arg.substr( std::string_view{ "--replay-input=" }.size() );
+            }
+            else if( arg.starts_with( "--replay-report=" ) )
+            {
+                options.replayReportPath = arg.substr( std::string_view{ "--replay-report=" }.size() );
+            }
+            else if( arg.starts_with( "--trace=" ) )
+            {
+                options.tracePath = arg.substr( std::string_view{ "--trace=" }.size() );
+            }
+            else if( arg == "--headless" )
+            {
+                options.headless = true;
+            }
+            else
+            {
+                std::cerr << "Unknown argument: " << arg << "\n";
+                return std::nullopt;
+            }
+        }
+
+        if( options.quitAfterStartup && !options.startupReport )
+        {
+            std::cerr << "--quit-after-startup requires --startup-report\n";
+            return std::nullopt;
+        }
+
+        if( !options.recordInputPath.empty() && !options.replayInputPath.empty() )
+        {
+            std::cerr << "--record-input and --replay-input are mutually exclusive\n";
+            return std::nullopt;
+        }
+
+        if( options.headless && options.replayInputPath.empty() )
+        {
+            std::cerr << "--headless requires --replay-input\n";
+            return std::nullopt;
+        }
+
+        return options;
+    }
+
+    void LaunchOptions::printUsage( const char* program )
+    {
+        std::cout << "Usage: " << program << " [options]\n"
+                  << "\n"
+                  << "Options:\n"
+                  << "  --memory-budget=MB  Memory kept for derived VIS data, least recently used\n"
+                  << "                      versions are evicted past it (default "
+                  << k_defaultMemoryBudgetMb << ", 0 = unlimited)\n"
+                  << "  --rendering-mode=event|adaptive|polling|budgeted\n"
+                  << "                      Initial rendering mode (default event)\n"
+                  << "  --target-fps=N      Frame cap of the budgeted mode (default "
+                  << RenderingMode::k_defaultTargetFps << ")\n"
+                  << "  --startup-report[=PATH]\n"
+                  << "                      Print startup phase timings as JSON (to PATH if given)\n"
+                  << "                      once every VIS version is loaded\n"
+                  << "  --quit-after-startup\n"
+                  << "                      Exit after writing the startup report\n"
+                  << "  --record-input=PATH Record the input of every frame to PATH for replay\n"
+                  << "  --replay-input=PATH Replay a recording instead of live input, print frame\n"
+                  << "                      timings as JSON and exit\n"
+                  << "  --replay-report=PATH\n"
+                  << "                      Write the replay timings to PATH instead of stdout\n"
+                  << "  --headless          Replay without a window or OpenGL (with --replay-input)\n"
+                  << "  --trace=PATH        Trace from launch and write Chrome trace-event JSON to PATH\n"
+                  << "                      on exit (open in chrome://tracing or ui.perfetto.dev)\n"
+                  << "  -h, --help          Show this help\n";
+    }
+} // namespace nfx::vista
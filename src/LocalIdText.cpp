@@ -0,0 +1,151 @@
+#include "LocalIdText.h"
+#include "CodebookCache.h"
+#include "diagnostics/AllocationTracker.h"
+
+using namespace dnv::vista::sdk;
+
+namespace nfx::vista
+{
+    namespace
+    {
+        // Separator: '-' for standard values, '~' for custom ones; Detail always uses '-'
+        void appendTag(
+            std::string& out,
+            const char* prefix,
+            const std::string& value,
+            CodebookName codebook,
+            const CodebookCache* codebooks )
+        {
+            if( value.empty() )
+            {
+                return;
+            }
+
+            const bool isCustom =
+                codebook != CodebookName::Detail && codebooks && !codebooks->isStandardValue( codebook, value );
+
+            out += '/';
+            out += prefix;
+            out += ( isCustom ? '~' : '-' );
+            out += value;
+        }
+    } // namespace
+
+    void composeLocalId( const LocalIdParts& parts, const CodebookCache* codebooks, std::string& out )
+    {
+        out.clear();
+
+        // Use SDK builder if all paths are valid (to support verbose mode)
+        if( parts.primary && ( parts.secondaryText.empty() || parts.secondary ) )
+        {
+            auto allocations = AllocationTracker::scope( AllocationTag::Sdk );
+            auto builder = dnv::vista::sdk::LocalIdBuilder::create( parts.version ).withVerboseMode( parts.verbose );
+            builder = std::move( builder ).withPrimaryItem( *parts.primary );
+
+            if( parts.secondary )
+            {
+                builder = std::move( builder ).withSecondaryItem( *parts.secondary );
+            }
+
+            out = builder.toString();
+        }
+        else
+        {
+            // Build manually if any path is invalid
+            out = "/dnv-v2/vis-";
+            out += VisVersions::toString( parts.version );
+
+            if( !parts.primaryText.empty() )
+            {
+                out += '/';
+                out += parts.primaryText;
+            }
+
+            if( !parts.secondaryText.empty() )
+            {
+                out += "/sec/";
+                out += parts.secondaryText;
+            }
+        }
+
+        if( parts.primaryText.empty() && !parts.primary )
+        {
+            return;
+        }
+
+        // Add /meta section if not already present (from SDK builder)
+        if( out.find( "/meta" ) == std::string::npos )
+        {
+            out += "/meta";
+        }
+
+        if( parts.tags )
+        {
+            const auto& tags = *parts.tags;
+            appendTag( out, "qty", tags.quantity, CodebookName::Quantity, codebooks );
+            appendTag( out, "cnt", tags.content, CodebookName::Content, codebooks );
+            appendTag( out, "calc", tags.calculation, CodebookName::Calculation, codebooks );
+            appendTag( out, "state", tags.state, CodebookName::State, codebooks );
+            appendTag( out, "cmd", tags.command, CodebookName::Command, codebooks );
+            appendTag( out, "type", tags.type, CodebookName::Type, codebooks );
+            appendTag( out, "pos", tags.position, CodebookName::Position, codebooks );
+            appendTag( out, "detail", tags.detail, CodebookName::Detail, codebooks );
+        }
+    }
+
+    std::optional<std::string> applyLocation( const GmodPath& path, std::string_view location )
+    {
+        // Find the first individualizable set to know which segment gets the location
+        const auto sets = path.individualizableSets();
+        if( sets.empty() )
+        {
+            return std::nullopt;
+        }
+
+        // Get the clean path string (no locations) using the SDK
+        const std::string cleanPath = path.withoutLocations().toString();
+
+        // The set's node is a full path index: count the short path segments (leaves and the target) before it
+        size_t shortSegIdx = 0;
+        size_t shortSeg = 0;
+        const auto target = static_cast<size_t>( sets[0].nodeIndices().front() );
+        for( size_t i = 0; i < path.length(); ++i )
+        {
+            if( !path[i].isLeafNode() && i != path.length() - 1 )
+            {
+                continue;
+            }
+            if( i == target )
+            {
+                shortSegIdx = shortSeg;
+                break;
+            }
+            shortSeg++;
+        }
+
+        // Split cleanPath by '/', insert location on shortSegIdx-th segment
+        std::string newPath;
+        newPath.reserve( cleanPath.size() + location.size() + 1 );
+        std::string_view remaining( cleanPath );
+        for( size_t segN = 0; !remaining.empty(); ++segN )
+        {
+            const auto slash = remaining.find( '/' );
+            const auto seg = ( slash == std::string_view::npos ) ? remaining : remaining.substr( 0, slash );
+
+            if( !newPath.empty() )
+            {
+                newPath += '/';
+            }
+            newPath += seg;
+            if( segN == shortSegIdx )
+            {
+                newPath += '-';
+                newPath += location;
+            }
+
+            remaining = ( slash == std::string_view::npos ) ? std::string_view{} : remaining.substr( slash + 1 );
+        }
+
+        return newPath;
+    }
+} // namespace nfx::vista
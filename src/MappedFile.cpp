@@ -0,0 +1,103 @@
+#include "MappedFile.h"
+
+#if defined( _WIN32 )
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace nfx::vista
+{
+    MappedFile::~MappedFile()
+    {
+#if defined( _WIN32 )
+        if( m_data )
+        {
+            UnmapViewOfFile( m_data );
+        }
+        if( m_mapping )
+        {
+            CloseHandle( m_mapping );
+        }
+        if( m_file )
+        {
+            CloseHandle( m_file );
+        }
+#else
+        if( m_data )
+        {
+            munmap( const_cast<std::byte*>( m_data ), m_size );
+        }
+#endif
+    }
+
+    std::unique_ptr<MappedFile> MappedFile::open( const std::filesystem::path& path )
+    {
+        std::unique_ptr<MappedFile> file( new MappedFile() );
+
+#if defined( _WIN32 )
+        HANDLE handle = CreateFileW(
+            path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+        if( handle == INVALID_HANDLE_VALUE )
+        {
+            return nullptr;
+        }
+        file->m_file = handle;
+
+        LARGE_INTEGER size;
+        if( !GetFileSizeEx( handle, &size ) || size.QuadPart == 0 )
+        {
+            return nullptr;
+        }
+
+        file->m_mapping = CreateFileMappingW( handle, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        if( !file->m_mapping )
+        {
+            return nullptr;
+        }
+
+        void* view = MapViewOfFile( file->m_mapping, FILE_MAP_READ, 0, 0, 0 );
+        if( !view )
+        {
+            return nullptr;
+        }
+
+        file->m_data = static_cast<const std::byte*>( view );
+        file->m_size = static_cast<size_t>( size.QuadPart );
+#else
+        const int fd = ::open( path.c_str(), O_RDONLY | O_CLOEXEC );
+        if( fd < 0 )
+        {
+            return nullptr;
+        }
+
+        struct stat st;
+        if( fstat( fd, &st ) != 0 || st.st_size == 0 )
+        {
+            ::close( fd );
+            return nullptr;
+        }
+
+        void* view = mmap( nullptr, static_cast<size_t>( st.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+        ::close( fd ); // The mapping keeps the file referenced
+        if( view == MAP_FAILED )
+        {
+            return nullptr;
+        }
+
+        file->m_data = static_cast<const std::byte*>( view );
+        file->m_size = static_cast<size_t>( st.st_size );
+#endif
+
+        return file;
+    }
+} // namespace nfx::vista
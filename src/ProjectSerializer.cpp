@@ -1,4 +1,5 @@
 #include "ProjectSerializer.h"
+#include "diagnostics/Tracer.h"
 
 #include <fstream>
 #include <sstream>
@@ -60,6 +61,8 @@ namespace nfx::vista
 
     std::optional<Project> ProjectSerializer::load( const std::string& path )
     {
+        auto trace = Tracer::scope( "ProjectSerializer::load", "io" );
+
         std::ifstream f( path );
         if( !f )
         {
@@ -171,6 +174,8 @@ namespace nfx::vista
 
     bool ProjectSerializer::save( const Project& p, const std::string& path )
     {
+        auto trace = Tracer::scope( "ProjectSerializer::save", "io" );
+
         nfx::json::Builder b( { .indent = 2 } );
 
         b.writeStartObject();
@@ -0,0 +1,132 @@
+#include "ShortPathIndex.h"
+#include "GmodIndex.h"
+
+#include <algorithm>
+#include <cctype>
+
+using namespace dnv::vista::sdk;
+
+namespace nfx::vista
+{
+    namespace
+    {
+        // Codes are upper case but for the lowercase suffixes of individualizable and selection nodes
+        // (411.1i, C101.31s): ranges are ordered and matched with the case folded on both sides
+        char fold( char c )
+        {
+            return static_cast<char>( std::toupper( static_cast<unsigned char>( c ) ) );
+        }
+
+        bool lessFolded( std::string_view a, std::string_view b )
+        {
+            return std::lexicographical_compare(
+                a.begin(), a.end(), b.begin(), b.end(), []( char x, char y ) { return fold( x ) < fold( y ); } );
+        }
+
+        bool startsWithFolded( std::string_view text, std::string_view prefix )
+        {
+            return text.size() >= prefix.size() &&
+                   std::equal( prefix.begin(), prefix.end(), text.begin(), []( char x, char y ) {
+                       return fold( x ) == fold( y );
+                   } );
+        }
+    } // namespace
+
+    std::unique_ptr<const ShortPathIndex> ShortPathIndex::build( const Gmod& gmod, const GmodIndex& index )
+    {
+        std::unique_ptr<ShortPathIndex> table( new ShortPathIndex() );
+        const auto nodeCount = static_cast<uint32_t>( index.nodeCount() );
+        table->m_ranges.resize( nodeCount );
+        table->m_root = index.indexOf( gmod.rootNode().code() ).value_or( 0 );
+
+        // Children as GmodIndex positions, resolved once
+        std::vector<std::vector<uint32_t>> children( nodeCount );
+        for( uint32_t i = 0; i < nodeCount; ++i )
+        {
+            for( const GmodNode* child : index.node( i ).children() )
+            {
+                if( auto c = index.indexOf( child->code() ) )
+                {
+                    children[i].push_back( *c );
+                }
+            }
+        }
+
+        // Product subtrees are shared between leaves: stamp visits per origin instead of clearing a set
+        std::vector<uint32_t> visited( nodeCount, 0 );
+        uint32_t stamp = 0;
+        std::vector<uint32_t> stack;
+
+        for( uint32_t origin = 0; origin < nodeCount; ++origin )
+        {
+            if( origin != table->m_root && !index.node( origin ).isLeafNode() )
+            {
+                continue;
+            }
+
+            ++stamp;
+            const auto offset = static_cast<uint32_t>( table->m_pool.size() );
+            stack.assign( children[origin].begin(), children[origin].end() );
+
+            while( !stack.empty() )
+            {
+                const uint32_t n = stack.back();
+                stack.pop_back();
+                if( visited[n] == stamp )
+                {
+                    continue;
+                }
+                visited[n] = stamp;
+
+                table->m_pool.push_back( n );
+                if( !index.node( n ).isLeafNode() )
+                {
+                    // A leaf is always written out: what lies below it is reached from its own entry
+                    stack.insert( stack.end(), children[n].begin(), children[n].end() );
+                }
+            }
+
+            std::sort( table->m_pool.begin() + offset, table->m_pool.end(), [&index]( uint32_t a, uint32_t b ) {
+                return lessFolded( index.node( a ).code(), index.node( b ).code() );
+            } );
+            table->m_ranges[origin] = { offset, static_cast<uint32_t>( table->m_pool.size() ) - offset };
+        }
+
+        table->m_pool.shrink_to_fit();
+        return table;
+    }
+
+    std::span<const uint32_t> ShortPathIndex::next( uint32_t origin ) const
+    {
+        if( origin >= m_ranges.size() )
+        {
+            return {};
+        }
+        const auto& range = m_ranges[origin];
+        return std::span<const uint32_t>( m_pool ).subspan( range.offset, range.count );
+    }
+
+    std::span<const uint32_t> ShortPathIndex::next(
+        const GmodIndex& index, uint32_t origin, std::string_view codePrefix ) const
+    {
+        const auto all = next( origin );
+        if( codePrefix.empty() )
+        {
+            return all;
+        }
+
+        // Matches are contiguous in folded code order: both ends by binary search
+        const auto first = std::partition_point( all.begin(), all.end(), [&index, codePrefix]( uint32_t n ) {
+            return lessFolded( index.node( n ).code(), codePrefix );
+        } );
+        const auto last = std::partition_point( first, all.end(), [&index, codePrefix]( uint32_t n ) {
+            return startsWithFolded( index.node( n ).code(), codePrefix );
+        } );
+        return all.subspan( static_cast<size_t>( first - all.begin() ), static_cast<size_t>( last - first ) );
+    }
+
+    size_t ShortPathIndex::byteSize() const
+    {
+        return sizeof( *this ) + m_ranges.capacity() * sizeof( Range ) + m_pool.capacity() * sizeof( uint32_t );
+    }
+} // namespace nfx::vista
@@ -0,0 +1,142 @@
+#include "ThreadPool.h"
+#include "diagnostics/Tracer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace nfx::vista
+{
+    ThreadPool::ThreadPool( size_t threadCount )
+    {
+        if( threadCount == 0 )
+        {
+            threadCount = std::max( 1u, std::thread::hardware_concurrency() );
+        }
+
+        m_workers.reserve( threadCount );
+        for( size_t i = 0; i < threadCount; ++i )
+        {
+            m_workers.emplace_back( [this, i]() {
+                Tracer::setThreadName( "worker " + std::to_string( i + 1 ) );
+                workerLoop();
+            } );
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock( m_mutex );
+            m_stopping = true;
+            m_tasks.clear();
+            m_interactiveTasks.clear();
+        }
+        m_wakeup.notify_all();
+        m_idle.notify_all();
+
+        for( auto& worker : m_workers )
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::submit( std::function<void()> task, Priority priority )
+    {
+        {
+            std::lock_guard lock( m_mutex );
+            if( m_stopping )
+            {
+                return;
+            }
+            auto& queue = priority == Priority::Interactive ? m_interactiveTasks : m_tasks;
+            queue.push_back( std::move( task ) );
+        }
+        m_wakeup.notify_one();
+    }
+
+    void ThreadPool::parallelFor(
+        size_t count,
+        size_t chunkSize,
+        std::function<void( size_t begin, size_t end )> body,
+        std::function<void()> done,
+        Priority priority )
+    {
+        chunkSize = std::max<size_t>( chunkSize, 1 );
+        const size_t chunks = ( count + chunkSize - 1 ) / chunkSize;
+        if( chunks == 0 )
+        {
+            if( done )
+            {
+                submit( std::move( done ), priority );
+            }
+            return;
+        }
+
+        struct Loop
+        {
+            std::function<void( size_t, size_t )> body;
+            std::function<void()> done;
+            std::atomic<size_t> remaining;
+        };
+        auto loop = std::make_shared<Loop>();
+        loop->body = std::move( body );
+        loop->done = std::move( done );
+        loop->remaining.store( chunks, std::memory_order_relaxed );
+
+        for( size_t begin = 0; begin < count; begin += chunkSize )
+        {
+            const size_t end = std::min( count, begin + chunkSize );
+            submit(
+                [loop, begin, end]() {
+                    loop->body( begin, end );
+                    if( loop->remaining.fetch_sub( 1, std::memory_order_acq_rel ) == 1 && loop->done )
+                    {
+                        loop->done();
+                    }
+                },
+                priority );
+        }
+    }
+
+    void ThreadPool::waitIdle()
+    {
+        std::unique_lock lock( m_mutex );
+        m_idle.wait( lock, [this]() {
+            return m_stopping || ( m_tasks.empty() && m_interactiveTasks.empty() && m_running == 0 );
+        } );
+    }
+
+    void ThreadPool::workerLoop()
+    {
+        while( true )
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock lock( m_mutex );
+                m_wakeup.wait(
+                    lock, [this]() { return m_stopping || !m_tasks.empty() || !m_interactiveTasks.empty(); } );
+                if( m_stopping )
+                {
+                    return;
+                }
+                auto& queue = m_interactiveTasks.empty() ? m_tasks : m_interactiveTasks;
+                task = std::move( queue.front() );
+                queue.pop_front();
+                ++m_running;
+            }
+
+            task();
+
+            {
+                std::lock_guard lock( m_mutex );
+                --m_running;
+                if( m_tasks.empty() && m_interactiveTasks.empty() && m_running == 0 )
+                {
+                    m_idle.notify_all();
+                }
+            }
+        }
+    }
+} // namespace nfx::vista
@@ -0,0 +1,365 @@
+#include "VersionStore.h"
+#include "ThreadPool.h"
+#include "diagnostics/AllocationTracker.h"
+#include "diagnostics/Tracer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+
+using namespace dnv::vista::sdk;
+
+namespace nfx::vista
+{
+    VersionStore::VersionStore( const VIS& vis, ThreadPool& pool )
+        : m_vis{ vis },
+          m_pool{ pool }
+    {
+        for( const auto version : m_vis.versions() )
+        {
+            auto s = std::make_unique<Slot>();
+            s->entry.version = version;
+            m_slots.push_back( std::move( s ) );
+        }
+    }
+
+    void VersionStore::preloadAll()
+    {
+        // Newest first: the latest version is the one shown on the first frame
+        for( auto it = m_slots.rbegin(); it != m_slots.rend(); ++it )
+        {
+            Slot* s = it->get();
+            m_pool.submit( [this, s]() { load( *s ); } );
+        }
+    }
+
+    const VersionStore::Entry* VersionStore::find( VisVersion version ) const
+    {
+        const Slot* s = slot( version );
+        if( !s || s->state.load( std::memory_order_acquire ) != State::Ready )
+        {
+            return nullptr;
+        }
+        return &s->entry;
+    }
+
+    const VersionStore::Entry* VersionStore::use( VisVersion version )
+    {
+        Slot* s = slot( version );
+        if( !s )
+        {
+            return nullptr;
+        }
+
+        s->lastUse = ++m_useClock;
+
+        const State current = s->state.load( std::memory_order_acquire );
+        if( m_active != version )
+        {
+            m_active = version;
+            if( current == State::Ready )
+            {
+                ++m_hits;
+            }
+            else
+            {
+                ++m_misses;
+            }
+        }
+
+        if( current == State::Evicted )
+        {
+            queueReload( *s );
+        }
+
+        return current == State::Ready ? &s->entry : nullptr;
+    }
+
+    bool VersionStore::prefetch( VisVersion version )
+    {
+        Slot* s = slot( version );
+        if( !s || s->state.load( std::memory_order_acquire ) != State::Evicted )
+        {
+            return false;
+        }
+
+        if( m_budget > 0 )
+        {
+            // Room for one more version of average size
+            const auto r = residency();
+            const size_t average = r.residentVersions > 0 ? r.residentBytes / r.residentVersions : 0;
+            if( r.residentBytes + average > m_budget )
+            {
+                return false;
+            }
+        }
+
+        queueReload( *s );
+        return true;
+    }
+
+    std::vector<VisVersion> VersionStore::recentlyUsed( size_t count ) const
+    {
+        std::vector<const Slot*> used;
+        for( const auto& s : m_slots )
+        {
+            if( s->lastUse > 0 )
+            {
+                used.push_back( s.get() );
+            }
+        }
+
+        std::sort( used.begin(), used.end(), []( const Slot* a, const Slot* b ) { return a->lastUse > b->lastUse; } );
+
+        std::vector<VisVersion> result;
+        for( size_t i = 0; i < used.size() && i < count; ++i )
+        {
+            result.push_back( used[i]->entry.version );
+        }
+        return result;
+    }
+
+    void VersionStore::trim()
+    {
+        if( m_budget == 0 )
+        {
+            return;
+        }
+
+        size_t resident = residency().residentBytes;
+        while( resident > m_budget )
+        {
+            Slot* oldest = nullptr;
+            for( const auto& s : m_slots )
+            {
+                if( s->state.load( std::memory_order_acquire ) != State::Ready || s->entry.version == m_active )
+                {
+                    continue;
+                }
+                if( !oldest || s->lastUse < oldest->lastUse )
+                {
+                    oldest = s.get();
+                }
+            }
+
+            if( !oldest )
+            {
+                break;
+            }
+
+            resident -= oldest->entry.residentBytes();
+            evict( *oldest );
+        }
+    }
+
+    VersionStore::Residency VersionStore::residency() const
+    {
+        Residency r;
+        r.hits = m_hits;
+        r.misses = m_misses;
+        r.evictions = m_evictions;
+
+        for( const auto& s : m_slots )
+        {
+            if( s->state.load( std::memory_order_acquire ) == State::Ready )
+            {
+                r.residentBytes += s->entry.residentBytes();
+                ++r.residentVersions;
+            }
+        }
+
+        return r;
+    }
+
+    VersionStore::State VersionStore::state( VisVersion version ) const
+    {
+        const Slot* s = slot( version );
+        return s ? s->state.load( std::memory_order_acquire ) : State::Failed;
+    }
+
+    std::optional<VersionStore::LoadTimings> VersionStore::loadTimings( VisVersion version ) const
+    {
+        const Slot* s = slot( version );
+        if( !s )
+        {
+            return std::nullopt;
+        }
+
+        const State current = s->state.load( std::memory_order_acquire );
+        if( current != State::Ready && current != State::Failed )
+        {
+            return std::nullopt;
+        }
+        return s->entry.timings;
+    }
+
+    bool VersionStore::hasPendingLoads() const
+    {
+        return std::any_of( m_slots.begin(), m_slots.end(), []( const auto& s ) {
+            const State current = s->state.load( std::memory_order_acquire );
+            return current == State::Pending || current == State::Loading;
+        } );
+    }
+
+    std::vector<VisVersion> VersionStore::versions() const
+    {
+        std::vector<VisVersion> result;
+        result.reserve( m_slots.size() );
+        for( const auto& s : m_slots )
+        {
+            result.push_back( s->entry.version );
+        }
+        return result;
+    }
+
+    VersionStore::Slot* VersionStore::slot( VisVersion version ) const
+    {
+        for( const auto& s : m_slots )
+        {
+            if( s->entry.version == version )
+            {
+                return s.get();
+            }
+        }
+        return nullptr;
+    }
+
+    void VersionStore::load( Slot& s )
+    {
+        State expected = State::Pending;
+        if( !s.state.compare_exchange_strong( expected, State::Loading, std::memory_order_acq_rel ) )
+        {
+            return;
+        }
+
+        auto trace = Tracer::scope( "VersionStore::load", "load" );
+
+        using Clock = std::chrono::steady_clock;
+        auto& timings = s.entry.timings;
+        timings = {};
+        timings.start = Clock::now();
+
+        // Seconds since the previous lap, for the per-step breakdown
+        auto lap = [last = timings.start]() mutable {
+            const auto now = Clock::now();
+            const double seconds = std::chrono::duration<double>( now - last ).count();
+            last = now;
+            return seconds;
+        };
+
+        State result = State::Ready;
+
+        try
+        {
+            auto& entry = s.entry;
+            auto allocations = AllocationTracker::scope( AllocationTag::Sdk );
+            {
+                auto step = Tracer::scope( "VIS::gmod", "load" );
+                entry.gmod = &m_vis.gmod( entry.version );
+            }
+            timings.gmodSeconds = lap();
+            {
+                auto step = Tracer::scope( "VIS::codebooks", "load" );
+                entry.codebooks = &m_vis.codebooks( entry.version );
+            }
+            if( !entry.codebookCache )
+            {
+                // Kept across evictions: small, and a version flip in the builder must not rebuild it
+                auto step = Tracer::scope( "CodebookCache::build", "load" );
+                auto cacheAllocations = AllocationTracker::scope( AllocationTag::Other );
+                entry.codebookCache = CodebookCache::build( *entry.codebooks );
+            }
+            timings.codebooksSeconds = lap();
+            {
+                auto step = Tracer::scope( "VIS::locations", "load" );
+                entry.locations = &m_vis.locations( entry.version );
+            }
+            timings.locationsSeconds = lap();
+
+            // The index is ours, not the SDK's
+            auto indexAllocations = AllocationTracker::scope( AllocationTag::Other );
+            entry.index = loadIndex( entry );
+            entry.nodeCount = entry.index->nodeCount();
+            {
+                auto step = Tracer::scope( "ShortPathIndex::build", "load" );
+                entry.shortPaths = ShortPathIndex::build( *entry.gmod, *entry.index );
+            }
+            timings.indexSeconds = lap();
+        }
+        catch( const std::exception& e )
+        {
+            std::cerr << "Failed to load VIS " << VisVersions::toString( s.entry.version ) << ": " << e.what() << "\n";
+            result = State::Failed;
+        }
+
+        timings.end = Clock::now();
+        s.state.store( result, std::memory_order_release );
+        if( !s.settledOnce )
+        {
+            // Reloads after eviction do not count towards startup progress
+            s.settledOnce = true;
+            m_settled.fetch_add( 1, std::memory_order_acq_rel );
+        }
+
+        if( m_onChanged )
+        {
+            m_onChanged();
+        }
+    }
+
+    void VersionStore::evict( Slot& s )
+    {
+        // Only Ready slots are evicted, so no worker is writing the entry
+        s.state.store( State::Evicted, std::memory_order_release );
+        s.entry.index.reset();
+        s.entry.shortPaths.reset();
+        s.entry.indexFromSnapshot = false;
+        s.entry.nodeCount = 0;
+        ++m_evictions;
+    }
+
+    void VersionStore::queueReload( Slot& s )
+    {
+        // Back to Pending first so the reload is queued once, not once per frame
+        State expected = State::Evicted;
+        if( s.state.compare_exchange_strong( expected, State::Pending, std::memory_order_acq_rel ) )
+        {
+            m_pool.submit( [this, slot = &s]() { load( *slot ); } );
+        }
+    }
+
+    std::unique_ptr<const GmodIndex> VersionStore::loadIndex( Entry& entry )
+    {
+        // Snapshot I/O is best effort: without a writable cache directory the index is just rebuilt
+        std::filesystem::path snapshot;
+        try
+        {
+            snapshot = GmodIndex::snapshotPath( entry.version );
+        }
+        catch( const std::exception& e )
+        {
+            std::cerr << "Index snapshots disabled: " << e.what() << "\n";
+        }
+
+        if( !snapshot.empty() )
+        {
+            if( auto index = GmodIndex::loadSnapshot( snapshot, entry.version, *entry.gmod ) )
+            {
+                entry.indexFromSnapshot = true;
+                return index;
+            }
+        }
+
+        auto index = GmodIndex::build( entry.version, *entry.gmod );
+        entry.indexFromSnapshot = false;
+
+        if( !snapshot.empty() && index->saveSnapshot( snapshot ) )
+        {
+            GmodIndex::removeStaleSnapshots( entry.version );
+        }
+
+        return index;
+    }
+} // namespace nfx::vista
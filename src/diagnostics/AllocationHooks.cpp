@@ -0,0 +1,132 @@
+/**
+ * @file AllocationHooks.cpp
+ * @brief Global operator new/delete replacements counting every allocation in AllocationTracker
+ *
+ * Linked into the explorer and the benchmark through the core library only: the command line tool
+ * keeps the standard allocator, so its workers do not pay for accounting nobody reads.
+ */
+
+#include "diagnostics/AllocationTracker.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    using nfx::vista::AllocationTracker;
+
+    void* allocate( std::size_t size )
+    {
+        AllocationTracker::record( size );
+        return std::malloc( size == 0 ? 1 : size );
+    }
+
+    void* allocateAligned( std::size_t size, std::align_val_t alignment )
+    {
+        AllocationTracker::record( size );
+
+        const auto align = static_cast<std::size_t>( alignment );
+#if defined( _WIN32 )
+        return _aligned_malloc( size == 0 ? 1 : size, align );
+#else
+        // aligned_alloc requires the size to be a multiple of the alignment
+        const std::size_t rounded = ( ( size == 0 ? 1 : size ) + align - 1 ) / align * align;
+        return std::aligned_alloc( align, rounded );
+#endif
+    }
+
+    void deallocateAligned( void* ptr )
+    {
+#if defined( _WIN32 )
+        _aligned_free( ptr );
+#else
+        std::free( ptr );
+#endif
+    }
+} // namespace
+
+void* operator new( std::size_t size )
+{
+    if( void* ptr = allocate( size ) )
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[]( std::size_t size )
+{
+    if( void* ptr = allocate( size ) )
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new( std::size_t size, const std::nothrow_t& ) noexcept
+{
+    return allocate( size );
+}
+
+void* operator new[]( std::size_t size, const std::nothrow_t& ) noexcept
+{
+    return allocate( size );
+}
+
+void* operator new( std::size_t size, std::align_val_t alignment )
+{
+    if( void* ptr = allocateAligned( size, alignment ) )
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[]( std::size_t size, std::align_val_t alignment )
+{
+    if( void* ptr = allocateAligned( size, alignment ) )
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete( void* ptr ) noexcept
+{
+    std::free( ptr );
+}
+
+void operator delete[]( void* ptr ) noexcept
+{
+    std::free( ptr );
+}
+
+void operator delete( void* ptr, std::size_t ) noexcept
+{
+    std::free( ptr );
+}
+
+void operator delete[]( void* ptr, std::size_t ) noexcept
+{
+    std::free( ptr );
+}
+
+void operator delete( void* ptr, std::align_val_t ) noexcept
+{
+    deallocateAligned( ptr );
+}
+
+void operator delete[]( void* ptr, std::align_val_t ) noexcept
+{
+    deallocateAligned( ptr );
+}
+
+void operator delete( void* ptr, std::size_t, std::align_val_t ) noexcept
+{
+    deallocateAligned( ptr );
+}
+
+void operator delete[]( void* ptr, std::size_t, std::align_val_t ) noexcept
+{
+    deallocateAligned( ptr );
+}
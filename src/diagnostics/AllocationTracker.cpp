@@ -0,0 +1,147 @@
+/**
+ * @file AllocationTracker.cpp
+ * @brief Per-thread, per-tag allocation counters, fed by the hooks in AllocationHooks.cpp
+ */
+
+#include "diagnostics/AllocationTracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+
+namespace
+{
+    using nfx::vista::AllocationStats;
+    using nfx::vista::AllocationTag;
+    using nfx::vista::AllocationTracker;
+
+    constexpr size_t k_maxSlots = 128; ///< The last slot is shared by threads past the limit
+
+    struct Slot
+    {
+        std::array<std::atomic<uint64_t>, AllocationTracker::k_tagCount> counts{};
+        std::array<std::atomic<uint64_t>, AllocationTracker::k_tagCount> bytes{};
+    };
+
+    // Zero-initialized statics: usable before any constructor runs and after destructors ran
+    Slot g_slots[k_maxSlots];
+    std::atomic<size_t> g_slotCount{ 0 };
+
+    thread_local Slot* t_slot = nullptr;
+    thread_local AllocationTag t_tag = AllocationTag::Other;
+
+    Slot& localSlot()
+    {
+        if( !t_slot )
+        {
+            const size_t index = g_slotCount.fetch_add( 1, std::memory_order_relaxed );
+            t_slot = &g_slots[index < k_maxSlots ? index : k_maxSlots - 1];
+        }
+        return *t_slot;
+    }
+
+    void count( AllocationTag tag, std::size_t size )
+    {
+        Slot& slot = localSlot();
+        const auto i = static_cast<size_t>( tag );
+        slot.counts[i].fetch_add( 1, std::memory_order_relaxed );
+        slot.bytes[i].fetch_add( size, std::memory_order_relaxed );
+    }
+
+    AllocationTracker::Snapshot read( const Slot& slot )
+    {
+        AllocationTracker::Snapshot snapshot;
+        for( size_t i = 0; i < AllocationTracker::k_tagCount; ++i )
+        {
+            snapshot[i].count = slot.counts[i].load( std::memory_order_relaxed );
+            snapshot[i].bytes = slot.bytes[i].load( std::memory_order_relaxed );
+        }
+        return snapshot;
+    }
+} // namespace
+
+namespace nfx::vista
+{
+    AllocationTracker::Scope::Scope( AllocationTag tag )
+        : m_previous{ t_tag }
+    {
+        t_tag = tag;
+    }
+
+    AllocationTracker::Scope::~Scope()
+    {
+        t_tag = m_previous;
+    }
+
+    void AllocationTracker::record( size_t size )
+    {
+        count( t_tag, size );
+    }
+
+    AllocationTracker::Snapshot AllocationTracker::thread()
+    {
+        return read( localSlot() );
+    }
+
+    AllocationTracker::Snapshot AllocationTracker::process()
+    {
+        Snapshot total{};
+        const size_t used = std::min( g_slotCount.load( std::memory_order_relaxed ), k_maxSlots );
+        for( size_t s = 0; s < used; ++s )
+        {
+            const Snapshot slot = read( g_slots[s] );
+            for( size_t i = 0; i < k_tagCount; ++i )
+            {
+                total[i] += slot[i];
+            }
+        }
+        return total;
+    }
+
+    AllocationStats AllocationTracker::total( const Snapshot& snapshot )
+    {
+        AllocationStats sum;
+        for( const auto& stats : snapshot )
+        {
+            sum += stats;
+        }
+        return sum;
+    }
+
+    const char* AllocationTracker::name( AllocationTag tag )
+    {
+        switch( tag )
+        {
+            case AllocationTag::Other:
+                return "Other";
+            case AllocationTag::GmodViewer:
+                return "Gmod Viewer";
+            case AllocationTag::NodeDetails:
+                return "Node Details";
+            case AllocationTag::LocalIdBuilder:
+                return "LocalId Builder";
+            case AllocationTag::LocalIdInspector:
+                return "LocalId Inspector";
+            case AllocationTag::ProjectManager:
+                return "Project Manager";
+            case AllocationTag::Sdk:
+                return "Vista SDK";
+            case AllocationTag::ImGui:
+                return "ImGui";
+            case AllocationTag::Count:
+                break;
+        }
+        return "?";
+    }
+
+    void* AllocationTracker::imguiAlloc( size_t size, void* )
+    {
+        count( AllocationTag::ImGui, size );
+        return std::malloc( size );
+    }
+
+    void AllocationTracker::imguiFree( void* ptr, void* )
+    {
+        std::free( ptr );
+    }
+} // namespace nfx::vista
@@ -0,0 +1,93 @@
+#include "diagnostics/FrameProfiler.h"
+
+#include <algorithm>
+
+namespace nfx::vista
+{
+    void FrameProfiler::add( Section section, Clock::duration elapsed )
+    {
+        m_current[index( section )] += elapsed;
+        m_ran[index( section )] = true;
+    }
+
+    void FrameProfiler::endFrame( bool presented )
+    {
+        ++( presented ? m_presentedFrames : m_skippedFrames );
+
+        for( size_t i = 0; i < k_sectionCount; ++i )
+        {
+            if( !m_ran[i] )
+            {
+                continue;
+            }
+
+            auto& h = m_histories[i];
+            h.values[h.next] = std::chrono::duration<float, std::milli>( m_current[i] ).count();
+            h.next = ( h.next + 1 ) % k_historySize;
+            h.count = std::min( h.count + 1, k_historySize );
+
+            m_current[i] = Clock::duration::zero();
+            m_ran[i] = false;
+        }
+    }
+
+    FrameProfiler::Stats FrameProfiler::stats( Section section ) const
+    {
+        const auto& h = m_histories[index( section )];
+
+        Stats s;
+        s.samples = h.count;
+        if( h.count == 0 )
+        {
+            return s;
+        }
+
+        s.last = h.values[( h.next + k_historySize - 1 ) % k_historySize];
+
+        // Fixed-size scratch: the history is never larger than k_historySize
+        std::array<float, k_historySize> sorted;
+        std::copy_n( h.values.begin(), h.count, sorted.begin() );
+        std::sort( sorted.begin(), sorted.begin() + h.count );
+
+        auto percentile = [&]( double p ) {
+            const size_t rank = static_cast<size_t>( p * static_cast<double>( h.count - 1 ) + 0.5 );
+            return sorted[rank];
+        };
+
+        s.p50 = percentile( 0.50 );
+        s.p95 = percentile( 0.95 );
+        s.p99 = percentile( 0.99 );
+        s.max = sorted[h.count - 1];
+        return s;
+    }
+
+    const char* FrameProfiler::name( Section section )
+    {
+        switch( section )
+        {
+            case Section::NewFrame:
+                return "NewFrame";
+            case Section::GmodViewer:
+                return "Gmod Viewer";
+            case Section::SearchOverlay:
+                return "Search Overlay";
+            case Section::NodeDetails:
+                return "Node Details";
+            case Section::LocalIdBuilder:
+                return "LocalId Builder";
+            case Section::LocalIdInspector:
+                return "LocalId Inspector";
+            case Section::ProjectManager:
+                return "Project Manager";
+            case Section::Submit:
+                return "GL Submit";
+            case Section::Present:
+                return "Present";
+            case Section::Frame:
+                return "Frame";
+            case Section::Count:
+                break;
+        }
+        return "?";
+    }
+} // namespace nfx::vista
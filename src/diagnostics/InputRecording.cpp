@@ -0,0 +1,378 @@
+#include "diagnostics/InputRecording.h"
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+
+namespace nfx::vista
+{
+    namespace
+    {
+        constexpr char k_magic[8] = { 'N', 'F', 'X', 'I', 'N', 'P', 'U', 'T' };
+        constexpr uint32_t k_formatVersion = 1;
+
+        constexpr uint8_t k_frameDisplaySize = 0x01; ///< Frame flag: display size follows
+
+        // Event tags in the log, independent of ImGui's internal enum
+        enum EventTag : uint8_t
+        {
+            MousePos = 1,
+            MouseWheel,
+            MouseButton,
+            Key,
+            Text,
+            Focus
+        };
+
+        template <typename T>
+        void put( std::vector<uint8_t>& out, T value )
+        {
+            const auto* bytes = reinterpret_cast<const uint8_t*>( &value );
+            out.insert( out.end(), bytes, bytes + sizeof( T ) );
+        }
+
+        /**
+         * @brief Bounds-checked sequential reads over the loaded log
+         */
+        class Reader
+        {
+        public:
+            explicit Reader( const std::vector<uint8_t>& data )
+                : m_data{ data }
+            {
+            }
+
+            template <typename T>
+            bool get( T& value )
+            {
+                if( m_data.size() - m_offset < sizeof( T ) )
+                {
+                    return false;
+                }
+                std::memcpy( &value, m_data.data() + m_offset, sizeof( T ) );
+                m_offset += sizeof( T );
+                return true;
+            }
+
+            bool getString( std::string& value, size_t length )
+            {
+                if( m_data.size() - m_offset < length )
+                {
+                    return false;
+                }
+                value.assign( reinterpret_cast<const char*>( m_data.data() ) + m_offset, length );
+                m_offset += length;
+                return true;
+            }
+
+            bool atEnd() const
+            {
+                return m_offset == m_data.size();
+            }
+
+        private:
+            const std::vector<uint8_t>& m_data;
+            size_t m_offset = 0;
+        };
+    } // namespace
+
+    //----------------------------------------------
+    // InputRecorder
+    //----------------------------------------------
+
+    InputRecorder::~InputRecorder()
+    {
+        m_file.flush();
+    }
+
+    std::unique_ptr<InputRecorder> InputRecorder::open(
+        const std::filesystem::path& path, std::string_view visVersion, std::string_view iniSettings )
+    {
+        std::unique_ptr<InputRecorder> recorder( new InputRecorder() );
+        recorder->m_file.open( path, std::ios::binary | std::ios::trunc );
+        if( !recorder->m_file )
+        {
+            std::cerr << "Failed to open input recording " << path.string() << "\n";
+            return nullptr;
+        }
+
+        auto& out = recorder->m_buffer;
+        out.insert( out.end(), std::begin( k_magic ), std::end( k_magic ) );
+        put( out, k_formatVersion );
+        put( out, static_cast<uint16_t>( visVersion.size() ) );
+        out.insert( out.end(), visVersion.begin(), visVersion.end() );
+        put( out, static_cast<uint32_t>( iniSettings.size() ) );
+        out.insert( out.end(), iniSettings.begin(), iniSettings.end() );
+
+        recorder->m_file.write( reinterpret_cast<const char*>( out.data() ), static_cast<std::streamsize>( out.size() ) );
+        return recorder;
+    }
+
+    void InputRecorder::recordFrame()
+    {
+        const ImGuiContext& g = *ImGui::GetCurrentContext();
+        const ImGuiIO& io = g.IO;
+
+        auto& out = m_buffer;
+        out.clear();
+
+        const bool sizeChanged = io.DisplaySize.x != m_displayWidth || io.DisplaySize.y != m_displayHeight;
+        put( out, static_cast<uint8_t>( sizeChanged ? k_frameDisplaySize : 0 ) );
+        put( out, io.DeltaTime );
+        if( sizeChanged )
+        {
+            m_displayWidth = io.DisplaySize.x;
+            m_displayHeight = io.DisplaySize.y;
+            put( out, m_displayWidth );
+            put( out, m_displayHeight );
+        }
+
+        // Count is patched once the events are written
+        const size_t countOffset = out.size();
+        put( out, uint16_t{ 0 } );
+
+        uint16_t count = 0;
+        for( const ImGuiInputEvent& e : g.InputEventsQueue )
+        {
+            // Trickled events stay queued across frames: record them the first time only
+            if( e.EventId <= m_lastEventId || count == UINT16_MAX )
+            {
+                continue;
+            }
+            m_lastEventId = e.EventId;
+
+            switch( e.Type )
+            {
+                case ImGuiInputEventType_MousePos:
+                    put( out, EventTag::MousePos );
+                    put( out, static_cast<uint8_t>( e.MousePos.MouseSource ) );
+                    put( out, e.MousePos.PosX );
+                    put( out, e.MousePos.PosY );
+                    break;
+                case ImGuiInputEventType_MouseWheel:
+                    put( out, EventTag::MouseWheel );
+                    put( out, static_cast<uint8_t>( e.MouseWheel.MouseSource ) );
+                    put( out, e.MouseWheel.WheelX );
+                    put( out, e.MouseWheel.WheelY );
+                    break;
+                case ImGuiInputEventType_MouseButton:
+                    put( out, EventTag::MouseButton );
+                    put( out, static_cast<uint8_t>( e.MouseButton.MouseSource ) );
+                    put( out, static_cast<uint8_t>( e.MouseButton.Button ) );
+                    put( out, static_cast<uint8_t>( e.MouseButton.Down ) );
+                    break;
+                case ImGuiInputEventType_Key:
+                    put( out, EventTag::Key );
+                    put( out, static_cast<int32_t>( e.Key.Key ) );
+                    put( out, static_cast<uint8_t>( e.Key.Down ) );
+                    put( out, e.Key.AnalogValue );
+                    break;
+                case ImGuiInputEventType_Text:
+                    put( out, EventTag::Text );
+                    put( out, static_cast<uint32_t>( e.Text.Char ) );
+                    break;
+                case ImGuiInputEventType_Focus:
+                    put( out, EventTag::Focus );
+                    put( out, static_cast<uint8_t>( e.AppFocused.Focused ) );
+                    break;
+                default:
+                    // Viewport hover events only matter with multi-viewports, which are not enabled
+                    continue;
+            }
+            ++count;
+        }
+
+        std::memcpy( out.data() + countOffset, &count, sizeof( count ) );
+        m_file.write( reinterpret_cast<const char*>( out.data() ), static_cast<std::streamsize>( out.size() ) );
+
+        ++m_frames;
+        m_events += count;
+    }
+
+    //----------------------------------------------
+    // InputReplay
+    //----------------------------------------------
+
+    std::unique_ptr<InputReplay> InputReplay::load( const std::filesystem::path& path )
+    {
+        std::ifstream file( path, std::ios::binary );
+        if( !file )
+        {
+            std::cerr << "Failed to open input recording " << path.string() << "\n";
+            return nullptr;
+        }
+        const std::vector<uint8_t> data{ std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() };
+
+        auto malformed = [&path]() {
+            std::cerr << "Malformed input recording " << path.string() << "\n";
+            return nullptr;
+        };
+
+        Reader in( data );
+        char magic[sizeof( k_magic )];
+        uint32_t formatVersion = 0;
+        if( !in.get( magic ) || std::memcmp( magic, k_magic, sizeof( k_magic ) ) != 0 || !in.get( formatVersion ) )
+        {
+            return malformed();
+        }
+        if( formatVersion != k_formatVersion )
+        {
+            std::cerr << "Unsupported input recording version " << formatVersion << " in " << path.string() << "\n";
+            return nullptr;
+        }
+
+        std::unique_ptr<InputReplay> replay( new InputReplay() );
+
+        uint16_t versionLength = 0;
+        uint32_t iniLength = 0;
+        if( !in.get( versionLength ) || !in.getString( replay->m_visVersion, versionLength ) ||
+            !in.get( iniLength ) || !in.getString( replay->m_iniSettings, iniLength ) )
+        {
+            return malformed();
+        }
+
+        float width = 0.f;
+        float height = 0.f;
+        while( !in.atEnd() )
+        {
+            uint8_t flags = 0;
+            Frame frame{};
+            uint16_t count = 0;
+            if( !in.get( flags ) || !in.get( frame.deltaTime ) )
+            {
+                return malformed();
+            }
+            if( ( flags & k_frameDisplaySize ) && ( !in.get( width ) || !in.get( height ) ) )
+            {
+                return malformed();
+            }
+            if( !in.get( count ) )
+            {
+                return malformed();
+            }
+
+            frame.displayWidth = width;
+            frame.displayHeight = height;
+            frame.firstEvent = static_cast<uint32_t>( replay->m_events.size() );
+            frame.eventCount = count;
+
+            for( uint16_t i = 0; i < count; ++i )
+            {
+                Event e{};
+                bool ok = in.get( e.type );
+                switch( e.type )
+                {
+                    case EventTag::MousePos:
+                    case EventTag::MouseWheel:
+                        ok = ok && in.get( e.source ) && in.get( e.x ) && in.get( e.y );
+                        break;
+                    case EventTag::MouseButton:
+                    {
+                        uint8_t button = 0;
+                        ok = ok && in.get( e.source ) && in.get( button ) && in.get( e.down );
+                        e.code = button;
+                        break;
+                    }
+                    case EventTag::Key:
+                        ok = ok && in.get( e.code ) && in.get( e.down ) && in.get( e.x );
+                        break;
+                    case EventTag::Text:
+                        ok = ok && in.get( e.character );
+                        break;
+                    case EventTag::Focus:
+                        ok = ok && in.get( e.down );
+                        break;
+                    default:
+                        ok = false;
+                        break;
+                }
+                if( !ok )
+                {
+                    return malformed();
+                }
+                replay->m_events.push_back( e );
+            }
+
+            replay->m_frames.push_back( frame );
+        }
+
+        return replay;
+    }
+
+    bool InputReplay::applyNextFrame()
+    {
+        if( finished() )
+        {
+            return false;
+        }
+
+        ImGuiContext& g = *ImGui::GetCurrentContext();
+        ImGuiIO& io = g.IO;
+
+        // Drop live input queued since the last replayed frame; trickled replay events stay
+        for( int i = g.InputEventsQueue.Size - 1; i >= 0; --i )
+        {
+            if( g.InputEventsQueue[i].EventId > m_lastEventId )
+            {
+                g.InputEventsQueue.erase( g.InputEventsQueue.Data + i );
+            }
+        }
+
+        const Frame& frame = m_frames[m_next++];
+        io.DeltaTime = frame.deltaTime;
+        io.DisplaySize = ImVec2( frame.displayWidth, frame.displayHeight );
+
+        for( uint32_t i = 0; i < frame.eventCount; ++i )
+        {
+            const Event& e = m_events[frame.firstEvent + i];
+            switch( e.type )
+            {
+                case EventTag::MousePos:
+                    io.AddMouseSourceEvent( static_cast<ImGuiMouseSource>( e.source ) );
+                    io.AddMousePosEvent( e.x, e.y );
+                    break;
+                case EventTag::MouseWheel:
+                    io.AddMouseSourceEvent( static_cast<ImGuiMouseSource>( e.source ) );
+                    io.AddMouseWheelEvent( e.x, e.y );
+                    break;
+                case EventTag::MouseButton:
+                    io.AddMouseSourceEvent( static_cast<ImGuiMouseSource>( e.source ) );
+                    io.AddMouseButtonEvent( e.code, e.down );
+                    break;
+                case EventTag::Key:
+                    io.AddKeyAnalogEvent( static_cast<ImGuiKey>( e.code ), e.down, e.x );
+                    break;
+                case EventTag::Text:
+                    io.AddInputCharacter( e.character );
+                    break;
+                case EventTag::Focus:
+                    io.AddFocusEvent( e.down );
+                    break;
+            }
+        }
+
+        m_lastEventId = g.InputEventsNextEventId - 1;
+        return true;
+    }
+
+    float InputReplay::initialWidth() const
+    {
+        return m_frames.empty() ? 0.f : m_frames.front().displayWidth;
+    }
+
+    float InputReplay::initialHeight() const
+    {
+        return m_frames.empty() ? 0.f : m_frames.front().displayHeight;
+    }
+
+    double InputReplay::recordedSeconds() const
+    {
+        return std::accumulate( m_frames.begin(), m_frames.end(), 0.0, []( double sum, const Frame& frame ) {
+            return sum + frame.deltaTime;
+        } );
+    }
+} // namespace nfx::vista
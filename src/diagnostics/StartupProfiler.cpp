@@ -0,0 +1,132 @@
+#include "diagnostics/StartupProfiler.h"
+#include "VersionStore.h"
+
+#include <dnv/vista/sdk/Transport.h>
+
+#include <algorithm>
+
+using namespace dnv::vista::sdk;
+
+namespace nfx::vista
+{
+    namespace
+    {
+        const char* stateName( VersionStore::State state )
+        {
+            switch( state )
+            {
+                case VersionStore::State::Pending:
+                    return "pending";
+                case VersionStore::State::Loading:
+                    return "loading";
+                case VersionStore::State::Ready:
+                    return "ready";
+                case VersionStore::State::Failed:
+                    return "failed";
+                case VersionStore::State::Evicted:
+                    return "evicted";
+            }
+            return "unknown";
+        }
+    } // namespace
+
+    void StartupProfiler::record( const char* name, Clock::time_point start, Clock::time_point end )
+    {
+        m_phases.push_back( Phase{ name, sinceOrigin( start ), std::chrono::duration<double, std::milli>( end - start ).count() } );
+    }
+
+    void StartupProfiler::markFirstFrame()
+    {
+        if( !m_firstFrameMs.has_value() )
+        {
+            m_firstFrameMs = sinceOrigin( Clock::now() );
+        }
+    }
+
+    void StartupProfiler::markInteractive()
+    {
+        if( !m_interactiveMs.has_value() )
+        {
+            m_interactiveMs = sinceOrigin( Clock::now() );
+        }
+    }
+
+    std::string StartupProfiler::report( const VersionStore& versions ) const
+    {
+        nfx::json::Builder b( { .indent = 2 } );
+
+        b.writeStartObject();
+
+        auto writeOptional = [&b]( const char* key, const std::optional<double>& value ) {
+            if( value )
+            {
+                b.write( key, *value );
+            }
+            else
+            {
+                b.write( key, nullptr );
+            }
+        };
+
+        writeOptional( "timeToFirstFrameMs", m_firstFrameMs );
+        writeOptional( "timeToInteractiveMs", m_interactiveMs );
+
+        // --- phases (main thread) ---
+        b.writeKey( "phases" );
+        b.writeStartArray();
+        for( const auto& phase : m_phases )
+        {
+            b.writeStartObject();
+            b.write( "name", phase.name );
+            b.write( "startMs", phase.startMs );
+            b.write( "durationMs", phase.durationMs );
+            b.writeEndObject();
+        }
+        b.writeEndArray();
+
+        // --- versions (worker threads) ---
+        std::optional<double> allLoadedMs = 0.0;
+        b.writeKey( "versions" );
+        b.writeStartArray();
+        for( const auto version : versions.versions() )
+        {
+            b.writeStartObject();
+            b.write( "version", std::string( VisVersions::toString( version ) ) );
+            b.write( "state", std::string( stateName( versions.state( version ) ) ) );
+
+            if( const auto timings = versions.loadTimings( version ) )
+            {
+                constexpr double msPerSecond = 1000.0;
+                const double endMs = sinceOrigin( timings->end );
+                b.write( "startMs", sinceOrigin( timings->start ) );
+                b.write( "endMs", endMs );
+                b.write( "gmodMs", timings->gmodSeconds * msPerSecond );
+                b.write( "codebooksMs", timings->codebooksSeconds * msPerSecond );
+                b.write( "locationsMs", timings->locationsSeconds * msPerSecond );
+                b.write( "indexMs", timings->indexSeconds * msPerSecond );
+
+                if( const auto* entry = versions.find( version ) )
+                {
+                    b.write( "indexFromSnapshot", entry->indexFromSnapshot );
+                }
+
+                if( allLoadedMs )
+                {
+                    allLoadedMs = std::max( *allLoadedMs, endMs );
+                }
+            }
+            else
+            {
+                allLoadedMs.reset();
+            }
+            b.writeEndObject();
+        }
+        b.writeEndArray();
+
+        writeOptional( "allVersionsLoadedMs", allLoadedMs );
+
+        b.writeEndObject();
+
+        return b.toString();
+    }
+} // namespace nfx::vista
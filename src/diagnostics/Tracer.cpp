@@ -0,0 +1,254 @@
+#include "diagnostics/Tracer.h"
+#include "ProjectSerializer.h"
+
+#include <dnv/vista/sdk/Transport.h>
+
+#include <array>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace nfx::vista
+{
+    namespace
+    {
+        constexpr size_t k_chunkEvents = 4096;
+        constexpr size_t k_maxChunks = 256; ///< ~1M events per thread and capture
+
+        struct Event
+        {
+            const char* name;
+            const char* category;
+            int64_t startNs;
+            int64_t durationNs;
+        };
+
+        struct Chunk
+        {
+            std::array<Event, k_chunkEvents> events;
+        };
+
+        /**
+         * @brief Written by its owning thread only; the controlling thread reads [0, count)
+         * @details A stale epoch means the buffer belongs to a previous capture. The owner resets
+         *          count before publishing the new epoch, so a reader that sees the current epoch
+         *          never sees events of an older capture. Chunks are kept and reused.
+         */
+        struct ThreadBuffer
+        {
+            uint32_t tid = 0;
+            std::string name; ///< Guarded by the registry mutex
+            std::atomic<uint64_t> epoch{ 0 };
+            std::atomic<size_t> count{ 0 };
+            std::atomic<size_t> dropped{ 0 };
+            std::array<std::atomic<Chunk*>, k_maxChunks> chunks{};
+
+            ~ThreadBuffer()
+            {
+                for( auto& chunk : chunks )
+                {
+                    delete chunk.load( std::memory_order_relaxed );
+                }
+            }
+        };
+
+        struct Registry
+        {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<ThreadBuffer>> buffers; ///< Outlive their threads until exit
+            std::atomic<uint64_t> epoch{ 0 };
+            Tracer::Clock::time_point origin = Tracer::Clock::now();
+        };
+
+        Registry& registry()
+        {
+            static Registry r;
+            return r;
+        }
+
+        ThreadBuffer& localBuffer()
+        {
+            thread_local ThreadBuffer* buffer = nullptr;
+            if( !buffer )
+            {
+                auto& r = registry();
+                std::lock_guard lock( r.mutex );
+                auto created = std::make_unique<ThreadBuffer>();
+                created->tid = static_cast<uint32_t>( r.buffers.size() + 1 );
+                created->name = "thread " + std::to_string( created->tid );
+                buffer = created.get();
+                r.buffers.push_back( std::move( created ) );
+            }
+            return *buffer;
+        }
+
+        int64_t sinceOrigin( Tracer::Clock::time_point t )
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>( t - registry().origin ).count();
+        }
+    } // namespace
+
+    std::atomic<bool> Tracer::s_capturing{ false };
+
+    void Tracer::setThreadName( std::string name )
+    {
+        ThreadBuffer& buffer = localBuffer();
+        std::lock_guard lock( registry().mutex );
+        buffer.name = std::move( name );
+    }
+
+    void Tracer::start()
+    {
+        registry().epoch.fetch_add( 1, std::memory_order_acq_rel );
+        s_capturing.store( true, std::memory_order_relaxed );
+    }
+
+    void Tracer::stop()
+    {
+        s_capturing.store( false, std::memory_order_relaxed );
+    }
+
+    void Tracer::record( const char* name, const char* category, Clock::time_point start, Clock::time_point end )
+    {
+        ThreadBuffer& b = localBuffer();
+
+        const uint64_t epoch = registry().epoch.load( std::memory_order_acquire );
+        if( b.epoch.load( std::memory_order_relaxed ) != epoch )
+        {
+            b.count.store( 0, std::memory_order_relaxed );
+            b.dropped.store( 0, std::memory_order_relaxed );
+            b.epoch.store( epoch, std::memory_order_release );
+        }
+
+        const size_t i = b.count.load( std::memory_order_relaxed );
+        const size_t c = i / k_chunkEvents;
+        if( c >= k_maxChunks )
+        {
+            b.dropped.fetch_add( 1, std::memory_order_relaxed );
+            return;
+        }
+
+        Chunk* chunk = b.chunks[c].load( std::memory_order_relaxed );
+        if( !chunk )
+        {
+            chunk = new Chunk();
+            b.chunks[c].store( chunk, std::memory_order_release );
+        }
+
+        chunk->events[i % k_chunkEvents] = Event{ name, category, sinceOrigin( start ), ( end - start ).count() };
+        b.count.store( i + 1, std::memory_order_release );
+    }
+
+    size_t Tracer::eventCount()
+    {
+        auto& r = registry();
+        const uint64_t epoch = r.epoch.load( std::memory_order_acquire );
+
+        std::lock_guard lock( r.mutex );
+        size_t total = 0;
+        for( const auto& b : r.buffers )
+        {
+            if( b->epoch.load( std::memory_order_acquire ) == epoch )
+            {
+                total += b->count.load( std::memory_order_acquire );
+            }
+        }
+        return total;
+    }
+
+    size_t Tracer::droppedCount()
+    {
+        auto& r = registry();
+        const uint64_t epoch = r.epoch.load( std::memory_order_acquire );
+
+        std::lock_guard lock( r.mutex );
+        size_t total = 0;
+        for( const auto& b : r.buffers )
+        {
+            if( b->epoch.load( std::memory_order_acquire ) == epoch )
+            {
+                total += b->dropped.load( std::memory_order_relaxed );
+            }
+        }
+        return total;
+    }
+
+    bool Tracer::write( const std::filesystem::path& path )
+    {
+        auto& r = registry();
+        const uint64_t epoch = r.epoch.load( std::memory_order_acquire );
+
+        nfx::json::Builder b( { .indent = 0 } );
+        b.writeStartObject();
+        b.write( "displayTimeUnit", std::string( "ms" ) );
+        b.writeKey( "traceEvents" );
+        b.writeStartArray();
+
+        {
+            // Only registration and names take the lock, writers keep appending meanwhile
+            std::lock_guard lock( r.mutex );
+            for( const auto& buffer : r.buffers )
+            {
+                b.writeStartObject();
+                b.write( "name", std::string( "thread_name" ) );
+                b.write( "ph", std::string( "M" ) );
+                b.write( "pid", 1 );
+                b.write( "tid", buffer->tid );
+                b.writeKey( "args" );
+                b.writeStartObject();
+                b.write( "name", buffer->name );
+                b.writeEndObject();
+                b.writeEndObject();
+
+                if( buffer->epoch.load( std::memory_order_acquire ) != epoch )
+                {
+                    continue;
+                }
+
+                const size_t count = buffer->count.load( std::memory_order_acquire );
+                for( size_t i = 0; i < count; ++i )
+                {
+                    const Chunk* chunk = buffer->chunks[i / k_chunkEvents].load( std::memory_order_acquire );
+                    const Event& e = chunk->events[i % k_chunkEvents];
+
+                    // Trace-event timestamps are microseconds
+                    b.writeStartObject();
+                    b.write( "name", std::string( e.name ) );
+                    b.write( "cat", std::string( e.category ) );
+                    b.write( "ph", std::string( "X" ) );
+                    b.write( "ts", static_cast<double>( e.startNs ) / 1000.0 );
+                    b.write( "dur", static_cast<double>( e.durationNs ) / 1000.0 );
+                    b.write( "pid", 1 );
+                    b.write( "tid", buffer->tid );
+                    b.writeEndObject();
+                }
+            }
+        }
+
+        b.writeEndArray();
+        b.writeEndObject();
+
+        std::ofstream f( path );
+        if( !f )
+        {
+            std::cerr << "Failed to write trace to " << path.string() << "\n";
+            return false;
+        }
+        f << b.toString() << "\n";
+        return true;
+    }
+
+    std::filesystem::path Tracer::defaultPath()
+    {
+        const auto dir = ProjectSerializer::defaultDir() / "traces";
+        std::filesystem::create_directories( dir );
+
+        const std::time_t now = std::time( nullptr );
+        char name[64];
+        std::strftime( name, sizeof( name ), "trace-%Y%m%d-%H%M%S.json", std::localtime( &now ) );
+        return dir / name;
+    }
+} // namespace nfx::vista
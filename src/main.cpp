@@ -1,4 +1,5 @@
 #include "Application.h"
+#include "LaunchOptions.h"
 
 #ifdef _WIN32
 extern "C"
@@ -12,14 +13,27 @@ extern "C"
 #    include <cstdlib>
 #endif
 
-int main()
+int main( int argc, char** argv )
 {
+    auto options = nfx::vista::LaunchOptions::parse( argc, argv );
+    if( !options.has_value() )
+    {
+        nfx::vista::LaunchOptions::printUsage( argv[0] );
+        return 1;
+    }
+
+    if( options->showHelp )
+    {
+        nfx::vista::LaunchOptions::printUsage( argv[0] );
+        return 0;
+    }
+
 #ifdef __linux__
     setenv( "__NV_PRIME_RENDER_OFFLOAD", "1", 1 );
     setenv( "__GLX_VENDOR_LIBRARY_NAME", "nvidia", 1 );
 #endif
 
-    nfx::vista::Application app;
+    nfx::vista::Application app{ options.value() };
     if( !app.initialize() )
     {
         return 1;
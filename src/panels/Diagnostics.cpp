@@ -0,0 +1,211 @@
+/**
+ * @file Diagnostics.cpp
+ * @brief Diagnostics panel implementation
+ *
+ * Displays CPU frame-time percentiles per panel and render stage, heap allocations per subsystem,
+ * and controls trace capture.
+ */
+
+#include "panels/Diagnostics.h"
+#include "FrameArena.h"
+#include "config/Theme.h"
+#include "diagnostics/AllocationTracker.h"
+#include "diagnostics/Tracer.h"
+
+#include <imgui.h>
+
+#include <cfloat>
+
+namespace nfx::vista
+{
+    void Diagnostics::render()
+    {
+        using Section = FrameProfiler::Section;
+
+        ImGui::SetNextWindowSize( ImVec2( 520, 360 ), ImGuiCond_FirstUseEver );
+        ImGui::Begin( "Diagnostics" );
+
+        ImGui::SeparatorText( "CPU frame time (ms)" );
+        ImGui::TextDisabled(
+            "Last %zu rendered frames. In event-driven mode frames only render on input.",
+            FrameProfiler::k_historySize );
+
+        constexpr ImGuiTableFlags tableFlags =
+            ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingStretchProp;
+
+        if( ImGui::BeginTable( "##FrameTimes", 6, tableFlags ) )
+        {
+            ImGui::TableSetupColumn( "Section", ImGuiTableColumnFlags_WidthStretch, 2.0f );
+            ImGui::TableSetupColumn( "Last" );
+            ImGui::TableSetupColumn( "p50" );
+            ImGui::TableSetupColumn( "p95" );
+            ImGui::TableSetupColumn( "p99" );
+            ImGui::TableSetupColumn( "Max" );
+            ImGui::TableHeadersRow();
+
+            for( size_t i = 0; i < static_cast<size_t>( Section::Count ); ++i )
+            {
+                const auto section = static_cast<Section>( i );
+                const auto stats = m_profiler.stats( section );
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+
+                // Row selects the plotted section
+                if( ImGui::Selectable(
+                        FrameProfiler::name( section ), m_plotted == section, ImGuiSelectableFlags_SpanAllColumns ) )
+                {
+                    m_plotted = section;
+                }
+
+                if( stats.samples == 0 )
+                {
+                    ImGui::TableNextColumn();
+                    ImGui::TextDisabled( "-" );
+                    continue;
+                }
+
+                ImGui::TableNextColumn();
+                ImGui::Text( "%.2f", stats.last );
+                ImGui::TableNextColumn();
+                ImGui::Text( "%.2f", stats.p50 );
+                ImGui::TableNextColumn();
+                ImGui::Text( "%.2f", stats.p95 );
+                ImGui::TableNextColumn();
+                ImGui::Text( "%.2f", stats.p99 );
+                ImGui::TableNextColumn();
+                ImGui::PushStyleColor( ImGuiCol_Text, Theme::TextWarning );
+                ImGui::Text( "%.2f", stats.max );
+                ImGui::PopStyleColor();
+            }
+
+            ImGui::EndTable();
+        }
+
+        const size_t presented = m_profiler.presentedFrames();
+        const size_t skipped = m_profiler.skippedFrames();
+        const size_t total = presented + skipped;
+        ImGui::Text(
+            "Frames: %zu presented, %zu skipped as identical (%.0f%%)",
+            presented,
+            skipped,
+            total > 0 ? 100.0 * static_cast<double>( skipped ) / static_cast<double>( total ) : 0.0 );
+
+        // History of the selected section, oldest on the left
+        const auto& history = m_profiler.history( m_plotted );
+        const int offset = history.count == FrameProfiler::k_historySize ? static_cast<int>( history.next ) : 0;
+
+        ImGui::Spacing();
+        ImGui::PlotLines(
+            "##History",
+            history.values.data(),
+            static_cast<int>( history.count ),
+            offset,
+            FrameProfiler::name( m_plotted ),
+            0.0f,
+            FLT_MAX,
+            ImVec2( -1.0f, 80.0f ) );
+
+        renderAllocations();
+        renderTraceControls();
+
+        ImGui::End();
+    }
+
+    void Diagnostics::renderAllocations()
+    {
+        ImGui::SeparatorText( "Heap allocations" );
+
+        // Rendered once per frame: the main thread's delta since the previous call is one frame
+        const auto current = AllocationTracker::thread();
+        const auto process = AllocationTracker::process();
+
+        constexpr ImGuiTableFlags tableFlags =
+            ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingStretchProp;
+
+        if( ImGui::BeginTable( "##Allocations", 4, tableFlags ) )
+        {
+            ImGui::TableSetupColumn( "Subsystem", ImGuiTableColumnFlags_WidthStretch, 2.0f );
+            ImGui::TableSetupColumn( "Last frame" );
+            ImGui::TableSetupColumn( "Bytes" );
+            ImGui::TableSetupColumn( "Total (all threads)" );
+            ImGui::TableHeadersRow();
+
+            for( size_t i = 0; i < AllocationTracker::k_tagCount; ++i )
+            {
+                const auto frame = current[i] - m_allocations[i];
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted( AllocationTracker::name( static_cast<AllocationTag>( i ) ) );
+                ImGui::TableNextColumn();
+                if( frame.count > 0 )
+                {
+                    ImGui::PushStyleColor( ImGuiCol_Text, Theme::TextWarning );
+                    ImGui::Text( "%llu", static_cast<unsigned long long>( frame.count ) );
+                    ImGui::PopStyleColor();
+                }
+                else
+                {
+                    ImGui::TextDisabled( "0" );
+                }
+                ImGui::TableNextColumn();
+                ImGui::Text( "%llu", static_cast<unsigned long long>( frame.bytes ) );
+                ImGui::TableNextColumn();
+                ImGui::Text( "%llu", static_cast<unsigned long long>( process[i].count ) );
+            }
+
+            ImGui::EndTable();
+        }
+
+        // Strings and vectors that only live for the frame come from here instead of the heap
+        ImGui::Text(
+            "Frame arena: %.1f KB used, %.1f KB peak, %.1f KB reserved",
+            static_cast<double>( FrameArena::used() ) / 1024.0,
+            static_cast<double>( FrameArena::peak() ) / 1024.0,
+            static_cast<double>( FrameArena::capacity() ) / 1024.0 );
+
+        m_allocations = current;
+    }
+
+    void Diagnostics::renderTraceControls()
+    {
+        ImGui::SeparatorText( "Trace" );
+
+        if( !Tracer::isCapturing() )
+        {
+            if( ImGui::Button( "Start capture" ) )
+            {
+                Tracer::start();
+                m_lastTrace.clear();
+            }
+        }
+        else
+        {
+            if( ImGui::Button( "Stop and save" ) )
+            {
+                Tracer::stop();
+                const auto path = Tracer::defaultPath();
+                m_lastTrace = Tracer::write( path ) ? path.string() : std::string{};
+            }
+            ImGui::SameLine();
+            ImGui::Text( "%zu events", Tracer::eventCount() );
+            if( const size_t dropped = Tracer::droppedCount(); dropped > 0 )
+            {
+                ImGui::SameLine();
+                ImGui::PushStyleColor( ImGuiCol_Text, Theme::TextWarning );
+                ImGui::Text( "(%zu dropped)", dropped );
+                ImGui::PopStyleColor();
+            }
+        }
+
+        if( !m_lastTrace.empty() )
+        {
+            ImGui::TextDisabled( "Saved %s", m_lastTrace.c_str() );
+            if( ImGui::IsItemHovered() )
+            {
+                ImGui::SetTooltip( "Open in chrome://tracing or ui.perfetto.dev" );
+            }
+        }
+    }
+} // namespace nfx::vista
@@ -13,7 +13,11 @@
  */
 
 #include "panels/GmodViewer.h"
+#include "GmodIndex.h"
+#include "VersionStore.h"
 #include "config/Theme.h"
+#include "diagnostics/AllocationTracker.h"
+#include "diagnostics/Tracer.h"
 
 #include <misc/cpp/imgui_stdlib.h>
 
@@ -23,53 +27,42 @@ using namespace dnv::vista::sdk;
 
 namespace nfx::vista
 {
-    GmodViewer::GmodViewer( const VIS& vis )
-        : m_vis{ vis }
+    GmodViewer::GmodViewer( const VIS& vis, const VersionStore& versions, ThreadPool& workers )
+        : m_vis{ vis },
+          m_versions{ versions },
+          m_searchResults{ workers }
     {
     }
 
-    std::string GmodViewer::buildFullPathString( const GmodNode* node ) const
+    FrameString GmodViewer::buildFullPathString( const GmodNode* node ) const
     {
+        FrameString fullPathStr( FrameArena::resource() );
         if( !node )
         {
-            return "";
+            return fullPathStr;
         }
 
-        std::string fullPathStr;
-        std::vector<std::string> pathParts;
-        const GmodNode* current = node;
-
         // Collect path from node to root
-        while( current )
+        FrameVector<const GmodNode*> pathNodes( FrameArena::resource() );
+        for( const GmodNode* current = node; current; )
         {
-            std::string part( current->code() );
-            if( current->location().has_value() )
-            {
-                part += "-";
-                part += current->location()->value();
-            }
-            pathParts.push_back( std::move( part ) );
-
-            if( !current->parents().isEmpty() )
-            {
-                current = current->parents()[0];
-            }
-            else
-            {
-                break;
-            }
+            pathNodes.push_back( current );
+            current = current->parents().isEmpty() ? nullptr : current->parents()[0];
         }
 
-        std::reverse( pathParts.begin(), pathParts.end() );
-
-        // Join with '/'
-        for( size_t i = 0; i < pathParts.size(); ++i )
+        // Join root to node with '/'
+        for( auto it = pathNodes.rbegin(); it != pathNodes.rend(); ++it )
         {
-            if( i > 0 )
+            if( it != pathNodes.rbegin() )
+            {
+                fullPathStr += '/';
+            }
+            fullPathStr += ( *it )->code();
+            if( ( *it )->location().has_value() )
             {
-                fullPathStr += "/";
+                fullPathStr += '-';
+                fullPathStr += ( *it )->location()->value();
             }
-            fullPathStr += pathParts[i];
         }
 
         return fullPathStr;
@@ -82,10 +75,11 @@ namespace nfx::vista
             return std::nullopt;
         }
 
-        std::string fullPathStr = buildFullPathString( node );
+        const FrameString fullPathStr = buildFullPathString( node );
         const auto& gmod = m_vis.gmod( version );
         const auto& locations = m_vis.locations( version );
 
+        auto allocations = AllocationTracker::scope( AllocationTag::Sdk );
         return GmodPath::fromFullPath( fullPathStr, gmod, locations );
     }
 
@@ -116,6 +110,18 @@ namespace nfx::vista
         }
     }
 
+    void GmodViewer::revealNode( const GmodNode& node, VisVersion version )
+    {
+        m_navigation.selectedNodeCode = std::string( node.code() );
+        m_navigation.scrollToNode = true;
+        m_navigation.expandSelectedNode = true;
+        notifyNodeSelection( &node, version );
+        if( m_onChanged )
+        {
+            m_onChanged();
+        }
+    }
+
     std::pair<ImVec4, ImVec4> GmodViewer::badgeColors( const GmodNode& node ) const
     {
         std::string_view category = node.metadata().category();
@@ -192,11 +198,25 @@ namespace nfx::vista
             ImGui::Text( "Category: %s", node.metadata().category().data() );
             ImGui::Text( "Type: %s", node.metadata().type().data() );
 
+            if( const auto* entry = m_versions.find( node.version() ) )
+            {
+                if( auto nodeIndex = entry->index->indexOf( node.code() ) )
+                {
+                    ImGui::Text(
+                        "Subtree: %u nodes, depth %u",
+                        entry->index->descendantCount( *nodeIndex ),
+                        entry->index->depth( *nodeIndex ) );
+                }
+            }
+
             const auto& gmod = m_vis.gmod( node.version() );
             const auto& locations = m_vis.locations( node.version() );
 
-            std::string fullPath = buildFullPathString( &node );
-            auto gmodPathOpt = GmodPath::fromFullPath( fullPath, gmod, locations );
+            const FrameString fullPath = buildFullPathString( &node );
+            auto gmodPathOpt = [&]() {
+                auto allocations = AllocationTracker::scope( AllocationTag::Sdk );
+                return GmodPath::fromFullPath( fullPath, gmod, locations );
+            }();
 
             if( gmodPathOpt.has_value() )
             {
@@ -215,10 +235,25 @@ namespace nfx::vista
         return clicked;
     }
 
-    void GmodViewer::render( VisVersion version )
+    bool GmodViewer::render( VisVersion version )
     {
+        auto trace = Tracer::scope( "GmodViewer::render", "ui" );
+
         ImGui::SetNextWindowSize( ImVec2( 800, 600 ), ImGuiCond_FirstUseEver );
-        ImGui::Begin( "Gmod Viewer" );
+        if( !ImGui::Begin( "Gmod Viewer" ) )
+        {
+            // Pending navigation (revealNode) is kept and applied once the tree is drawn again
+            ImGui::End();
+            return false;
+        }
+
+        const auto* entry = m_versions.find( version );
+        if( !entry )
+        {
+            ImGui::TextDisabled( "Loading VIS %s...", VisVersions::toString( version ).data() );
+            ImGui::End();
+            return true;
+        }
 
         renderHelp();
         ImGui::Separator();
@@ -226,19 +261,27 @@ namespace nfx::vista
         renderHeader();
         ImGui::Separator();
 
-        const auto& gmod = m_vis.gmod( version );
-
         // Always show tree
-        renderTree( gmod, version );
+        renderTree( *entry->index, version );
 
         ImGui::End();
+        return true;
+    }
+
+    void GmodViewer::renderOverlay( VisVersion version )
+    {
+        auto trace = Tracer::scope( "GmodViewer::renderOverlay", "ui" );
+        const auto* entry = m_versions.find( version );
+        if( !entry )
+        {
+            return;
+        }
 
-        const auto& gmodForSearch = m_vis.gmod( version );
         bool showOverlay = !m_search.buffer.empty() && ( m_search.boxHasFocus || m_search.overlayHovered );
 
         if( showOverlay )
         {
-            renderSearchResultsOverlay( gmodForSearch, version );
+            renderSearchResultsOverlay( *entry->gmod, entry->index, version );
         }
         else if( !m_search.buffer.empty() )
         {
@@ -259,6 +302,12 @@ namespace nfx::vista
 
         std::string previousBuffer = m_search.buffer;
 
+        if( m_search.focusRequested )
+        {
+            ImGui::SetKeyboardFocusHere();
+            m_search.focusRequested = false;
+        }
+
         ImGui::InputTextWithHint( "##search", "Search nodes (code or name)...", &m_search.buffer );
 
         // Increment search ID when buffer changes (new search) to force window reordering
@@ -324,7 +373,7 @@ namespace nfx::vista
         }
     }
 
-    void GmodViewer::renderTree( const Gmod& gmod, VisVersion version )
+    void GmodViewer::renderTree( const GmodIndex& index, VisVersion version )
     {
         ImGui::BeginChild( "GmodTree", ImVec2( 0, 0 ), true );
 
@@ -334,333 +383,268 @@ namespace nfx::vista
         // - Function compositions: parent composed of children (not substitutable)
         // - Function selections: children are specializations of parent (substitutable, removed in vessel models)
         // - Function groups: organizational grouping
+        // Selections and Product Types are flattened once per version, see GmodIndex::displayChildren().
 
-        // Helper to check if a node will have visible children after filtering
-        auto hasVisibleChildren = [&]( const GmodNode& node ) -> bool {
-            if( node.children().isEmpty() )
-            {
-                return false;
-            }
-
-            auto nodeProductType = node.productType();
-            for( const auto* child : node.children() )
+        // Collect the ancestors of the navigation target so they are opened on the way down
+        m_navigation.expandPath.clear();
+        if( m_navigation.scrollToNode && !m_navigation.selectedNodeCode.empty() )
+        {
+            if( auto target = index.indexOf( m_navigation.selectedNodeCode ) )
             {
-                // Skip if child is the Product Type (already shown as badge)
-                if( nodeProductType.has_value() && child == nodeProductType.value() )
+                for( uint32_t p = index.parent( *target ); p != GmodIndex::k_none; p = index.parent( p ) )
                 {
-                    // Check if Product Type has grandchildren
-                    if( !child->children().isEmpty() )
-                    {
-                        return true;
-                    }
-                    continue;
-                }
-
-                // Product Selections and Function Selections are skipped but their children are shown
-                if( child->isProductSelection() )
-                {
-                    if( !child->children().isEmpty() )
-                    {
-                        return true;
-                    }
-                }
-                else if(
-                    child->metadata().type() == "SELECTION" && ( child->metadata().category() == "PRODUCT FUNCTION" ||
-                                                                 child->metadata().category() == "ASSET FUNCTION" ) )
-                {
-                    if( !child->children().isEmpty() )
-                    {
-                        return true;
-                    }
-                }
-                else
-                {
-                    // This child will be rendered
-                    return true;
+                    m_navigation.expandPath.push_back( p );
                 }
             }
+        }
 
-            return false;
-        };
-
-        // Recursive function to render tree nodes
-        // parentNode: optional parent node to display as badge (for nodes promoted from skipped selections)
-        std::function<void( const GmodNode&, const GmodNode* )> renderNode;
-        renderNode = [&]( const GmodNode& node, const GmodNode* parentNode = nullptr ) {
-            // Push unique ID scope for this entire node (to avoid conflicts with nodes having same name)
-            ImGui::PushID( static_cast<const void*>( &node ) );
+        // Start from root node, children in natural order
+        for( uint32_t rootChild : index.rootChildren() )
+        {
+            renderTreeNode( index, rootChild, GmodIndex::k_none, version );
+        }
 
-            bool isProductType = node.metadata().category() == "PRODUCT" && node.metadata().type() == "TYPE";
-            auto [badgeBg, badgeText] = badgeColors( node );
+        ImGui::EndChild();
+    }
 
-            // Check if this is the target node for navigation
-            bool isTargetNode = m_navigation.scrollToNode && ( node.code() == m_navigation.selectedNodeCode );
-            bool isSelectedNode =
-                !m_navigation.selectedNodeCode.empty() && ( node.code() == m_navigation.selectedNodeCode );
+    // badgeIndex: optional parent node to display as badge (for nodes promoted from skipped selections)
+    void GmodViewer::renderTreeNode( const GmodIndex& index, uint32_t nodeIndex, uint32_t badgeIndex, VisVersion version )
+    {
+        const GmodNode& node = index.node( nodeIndex );
+        const GmodNode* parentNode = badgeIndex != GmodIndex::k_none ? &index.node( badgeIndex ) : nullptr;
 
-            // Render tree node
-            ImGui::AlignTextToFramePadding();
+        // Push unique ID scope for this entire node (to avoid conflicts with nodes having same name)
+        ImGui::PushID( static_cast<const void*>( &node ) );
 
-            char treeId[256];
-            snprintf( treeId, sizeof( treeId ), "##tree_%s_%p", node.code().data(), static_cast<const void*>( &node ) );
+        // Check if this is the target node for navigation
+        bool isTargetNode = m_navigation.scrollToNode && ( node.code() == m_navigation.selectedNodeCode );
+        bool isSelectedNode = !m_navigation.selectedNodeCode.empty() && ( node.code() == m_navigation.selectedNodeCode );
 
-            bool nodeOpen = false;
-            bool willHaveChildren = hasVisibleChildren( node );
+        // Render tree node
+        ImGui::AlignTextToFramePadding();
 
-            if( willHaveChildren )
-            {
-                // Check if we should auto-expand this node (if target is a descendant OR if it's the selected node)
-                bool shouldExpand = false;
-                if( m_navigation.scrollToNode && !m_navigation.selectedNodeCode.empty() )
-                {
-                    auto targetOpt = gmod.node( m_navigation.selectedNodeCode );
-                    if( targetOpt.has_value() )
-                    {
-                        const GmodNode* target = targetOpt.value();
-                        // Walk up from target to see if current node is an ancestor
-                        const GmodNode* current = target;
-                        while( !current->parents().isEmpty() )
-                        {
-                            current = current->parents()[0];
-                            if( current == &node )
-                            {
-                                shouldExpand = true;
-                                break;
-                            }
-                        }
-                    }
-                }
+        char treeId[256];
+        snprintf( treeId, sizeof( treeId ), "##tree_%s_%p", node.code().data(), static_cast<const void*>( &node ) );
 
-                // Also expand if this is the selected node and we want to expand it
-                if( isSelectedNode && m_navigation.expandSelectedNode )
-                {
-                    shouldExpand = true;
-                }
+        bool nodeOpen = false;
+        const auto children = index.displayChildren( nodeIndex );
 
-                if( shouldExpand )
-                {
-                    ImGui::SetNextItemOpen( true );
-                }
+        if( !children.empty() )
+        {
+            // Auto-expand if the target is a descendant OR if it's the selected node
+            const auto& expandPath = m_navigation.expandPath;
+            bool shouldExpand = std::find( expandPath.begin(), expandPath.end(), nodeIndex ) != expandPath.end();
 
-                nodeOpen = ImGui::TreeNodeEx(
-                    treeId,
-                    ImGuiTreeNodeFlags_SpanFullWidth | ImGuiTreeNodeFlags_OpenOnArrow |
-                        ImGuiTreeNodeFlags_AllowOverlap );
-                ImGui::SameLine();
-            }
-            else
+            if( isSelectedNode && m_navigation.expandSelectedNode )
             {
-                // Leaf nodes: display bullet instead of arrow
-                ImGui::TreeNodeEx(
-                    treeId,
-                    ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen | ImGuiTreeNodeFlags_Bullet |
-                        ImGuiTreeNodeFlags_SpanFullWidth | ImGuiTreeNodeFlags_AllowOverlap );
-                ImGui::SameLine();
+                shouldExpand = true;
             }
 
-            // Scroll to target node
-            if( isTargetNode )
+            if( shouldExpand )
             {
-                ImGui::SetScrollHereY( 0.5f );
-                m_navigation.scrollToNode = false;       // Reset flag after scrolling
-                m_navigation.expandSelectedNode = false; // Reset expand flag
+                ImGui::SetNextItemOpen( true );
             }
 
-            // Render parent badge if provided (for nodes from skipped selections)
-            if( parentNode != nullptr )
-            {
-                if( renderBadge( *parentNode ) )
-                {
-                    selectNode( *parentNode, version );
-                }
-                ImGui::SameLine();
-            }
+            nodeOpen = ImGui::TreeNodeEx(
+                treeId,
+                ImGuiTreeNodeFlags_SpanFullWidth | ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_AllowOverlap );
+            ImGui::SameLine();
+        }
+        else
+        {
+            // Leaf nodes: display bullet instead of arrow
+            ImGui::TreeNodeEx(
+                treeId,
+                ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen | ImGuiTreeNodeFlags_Bullet |
+                    ImGuiTreeNodeFlags_SpanFullWidth | ImGuiTreeNodeFlags_AllowOverlap );
+            ImGui::SameLine();
+        }
 
-            // Render main badge
-            if( renderBadge( node ) )
-            {
-                selectNode( node, version );
-            }
+        // Scroll to target node
+        if( isTargetNode )
+        {
+            ImGui::SetScrollHereY( 0.5f );
+            m_navigation.scrollToNode = false;       // Reset flag after scrolling
+            m_navigation.expandSelectedNode = false; // Reset expand flag
+        }
 
-            // Render Product Type badge if node has one
-            auto productTypeOpt = node.productType();
-            std::string_view category = node.metadata().category();
-            if( productTypeOpt.has_value() && ( category == "PRODUCT FUNCTION" || category == "ASSET FUNCTION" ) )
+        // Render parent badge if provided (for nodes from skipped selections)
+        if( parentNode != nullptr )
+        {
+            if( renderBadge( *parentNode ) )
             {
-                const auto* productTypeNode = productTypeOpt.value();
-                ImGui::SameLine();
-                if( renderBadge( *productTypeNode ) )
-                {
-                    selectNode( *productTypeNode, version );
-                }
+                selectNode( *parentNode, version );
             }
-
             ImGui::SameLine();
+        }
 
-            // Display name
-            if( node.metadata().commonName().has_value() )
+        // Render main badge
+        if( renderBadge( node ) )
+        {
+            selectNode( node, version );
+        }
+
+        // Render Product Type badge if node has one
+        auto productTypeOpt = node.productType();
+        std::string_view category = node.metadata().category();
+        if( productTypeOpt.has_value() && ( category == "PRODUCT FUNCTION" || category == "ASSET FUNCTION" ) )
+        {
+            const auto* productTypeNode = productTypeOpt.value();
+            ImGui::SameLine();
+            if( renderBadge( *productTypeNode ) )
             {
-                ImGui::TextUnformatted( node.metadata().commonName().value().data() );
+                selectNode( *productTypeNode, version );
             }
-            else
+        }
+
+        ImGui::SameLine();
+
+        // Display name
+        if( node.metadata().commonName().has_value() )
+        {
+            ImGui::TextUnformatted( node.metadata().commonName().value().data() );
+        }
+        else
+        {
+            ImGui::TextUnformatted( node.metadata().name().data() );
+        }
+
+        // Render children recursively
+        if( nodeOpen )
+        {
+            for( const auto& child : children )
             {
-                ImGui::TextUnformatted( node.metadata().name().data() );
+                const uint32_t childBadge = child.badge == GmodIndex::k_inherit ? badgeIndex : child.badge;
+                renderTreeNode( index, child.node, childBadge, version );
             }
+            ImGui::TreePop();
+        }
 
-            // Render children recursively
-            if( nodeOpen && !node.children().isEmpty() )
-            {
-                // Check if node has a Product Type to avoid rendering it twice
-                auto nodeProductType = node.productType();
+        ImGui::PopID();
+    }
 
-                for( const auto* child : node.children() )
-                {
-                    // Skip child if it's the same as the node's Product Type (already shown as badge)
-                    // But render its children (grandchildren)
-                    if( nodeProductType.has_value() && child == nodeProductType.value() )
-                    {
-                        // Render grandchildren as if they were direct children
-                        for( const auto* grandchild : child->children() )
-                        {
-                            if( grandchild->isProductSelection() )
-                            {
-                                for( const auto* greatGrandchild : grandchild->children() )
-                                {
-                                    renderNode( *greatGrandchild, &node );
-                                }
-                            }
-                            else if(
-                                grandchild->metadata().category() == "PRODUCT" &&
-                                grandchild->metadata().type() == "TYPE" )
-                            {
-                                renderNode( *grandchild, &node );
-                            }
-                            else
-                            {
-                                renderNode( *grandchild, nullptr );
-                            }
-                        }
-                        continue;
-                    }
+    GmodViewer::SearchResults GmodViewer::search(
+        std::string query,
+        VisVersion version,
+        const Gmod& gmod,
+        const Locations& locations,
+        std::shared_ptr<const GmodIndex> index )
+    {
+        auto trace = Tracer::scope( "GmodViewer::search", "search" );
 
-                    // Skip Product Selections (Component selections like CS1, CS2) but render their children
-                    // Reference: Vindøy (2008) Section 2.3 - "Component selections are groups of Components
-                    // with a parent and children. When the selection has been performed, the Component selection
-                    // is substituted by the selected child."
-                    if( child->isProductSelection() )
-                    {
-                        for( const auto* grandchild : child->children() )
-                        {
-                            renderNode( *grandchild, &node );
-                        }
-                    }
-                    // Skip Product Function Selections (Function selections like C101.2s) but render their children
-                    // Reference: Vindøy (2008) Section 2.2 - "Function selections are groups of Functions with
-                    // a parent and children. When applied to a vessel, it is generally allowed to select more
-                    // than one child. When the selection has been performed, the Function selection is removed."
-                    else if(
-                        child->metadata().type() == "SELECTION" &&
-                        ( child->metadata().category() == "PRODUCT FUNCTION" ||
-                          child->metadata().category() == "ASSET FUNCTION" ) )
-                    {
-                        for( const auto* grandchild : child->children() )
-                        {
-                            renderNode( *grandchild, &node );
-                        }
-                        continue; // Don't render the selection node itself
-                    }
-                    // Product Types get parent badge
-                    else if( child->metadata().category() == "PRODUCT" && child->metadata().type() == "TYPE" )
-                    {
-                        // If current node is also a Product Type, propagate the parent badge
-                        const GmodNode* badgeToShow = isProductType ? parentNode : &node;
-                        renderNode( *child, badgeToShow );
-                    }
-                    else
-                    {
-                        renderNode( *child, nullptr );
-                    }
-                }
-                ImGui::TreePop();
-            }
+        SearchResults results{ std::move( query ), version, std::nullopt, {} };
 
-            ImGui::PopID();
-        };
+        // Try to parse as GmodPath first (for path-based search like "411.1/C101")
+        std::string pathBuffer = results.query;
+        std::transform( pathBuffer.begin(), pathBuffer.end(), pathBuffer.begin(), ::toupper );
+        {
+            auto parse = Tracer::scope( "GmodPath::fromShortPath", "parse" );
+            auto allocations = AllocationTracker::scope( AllocationTag::Sdk );
+            results.parsedPath = GmodPath::fromShortPath( pathBuffer, gmod, locations );
+        }
+        if( results.parsedPath.has_value() )
+        {
+            return results;
+        }
+
+        // Convert search string to lowercase for case-insensitive search
+        std::string searchLower = results.query;
+        std::transform( searchLower.begin(), searchLower.end(), searchLower.begin(), ::tolower );
 
-        // Start from root node
-        const auto& rootNode = gmod.rootNode();
-        if( !rootNode.children().isEmpty() )
+        for( uint32_t i = 0; i < static_cast<uint32_t>( index->nodeCount() ); ++i )
         {
-            std::vector<const GmodNode*> sortedChildren;
-            for( const auto* child : rootNode.children() )
+            // Code, name or common name contains the search term (incremental: "c10" matches "C101", "C1082")
+            // Nodes ending with 'i' or 's' (individualizable/selections) are skipped: these are internal
+            // structure nodes, not actual items that can be referenced
+            if( index->isStructural( i ) || index->searchText( i ).find( searchLower ) == std::string_view::npos )
             {
-                sortedChildren.push_back( child );
+                continue;
             }
 
-            // Natural sort: extract numeric prefix for proper ordering
-            std::sort( sortedChildren.begin(), sortedChildren.end(), []( const GmodNode* a, const GmodNode* b ) {
-                auto extractNumber = []( std::string_view code ) -> int {
-                    int num = 0;
-                    for( char c : code )
+            const GmodNode& node = index->node( i );
+
+            // Find the last ASSET/PRODUCT FUNCTION LEAF in the path
+            const GmodNode* current = &node;
+            const GmodNode* lastFunctionLeaf = nullptr;
+
+            while( !current->parents().isEmpty() )
+            {
+                const GmodNode* parent = current->parents()[0];
+                if( parent->code() == "VE" )
+                    break;
+
+                std::string_view code = parent->code();
+                if( !code.empty() )
+                {
+                    char lastChar = code.back();
+                    bool isStructural = ( lastChar == 'i' || lastChar == 's' );
+
+                    if( !isStructural && !parent->isProductSelection() )
                     {
-                        if( c >= '0' && c <= '9' )
-                        {
-                            num = num * 10 + ( c - '0' );
-                        }
-                        else
+                        std::string_view category = parent->metadata().category();
+                        std::string_view type = parent->metadata().type();
+
+                        bool isFunctionLeaf =
+                            ( category == "ASSET FUNCTION" || category == "PRODUCT FUNCTION" ) && type == "LEAF";
+
+                        if( isFunctionLeaf )
                         {
-                            break;
+                            lastFunctionLeaf = parent;
                         }
                     }
-                    return num;
-                };
-                int numA = extractNumber( a->code() );
-                int numB = extractNumber( b->code() );
-                if( numA != numB )
-                {
-                    return numA < numB;
                 }
-                return a->code() < b->code();
-            } );
-
-            for( const auto* child : sortedChildren )
-            {
-                renderNode( *child, nullptr );
+                current = parent;
             }
+
+            results.matches.push_back( { &node, lastFunctionLeaf != &node ? lastFunctionLeaf : nullptr } );
         }
 
-        ImGui::EndChild();
+        return results;
     }
 
-    void GmodViewer::renderSearchResults( const Gmod& gmod, VisVersion version )
+    void GmodViewer::renderSearchResults(
+        const Gmod& gmod, const std::shared_ptr<const GmodIndex>& index, VisVersion version )
     {
-        // Convert search string to lowercase for case-insensitive search
-        std::string searchLower = m_search.buffer;
-        std::transform( searchLower.begin(), searchLower.end(), searchLower.begin(), ::tolower );
-
-        if( searchLower.empty() )
+        if( m_search.buffer.empty() )
         {
             ImGui::TextDisabled( "Type to search..." );
             return;
         }
 
-        // Try to parse as GmodPath first (for path-based search like "411.1/C101")
-        std::string pathBuffer = m_search.buffer;
-        std::transform( pathBuffer.begin(), pathBuffer.end(), pathBuffer.begin(), ::toupper );
+        // Matching runs on a worker, once per query; the overlay only draws published results
+        if( m_search.buffer != m_search.requestedQuery || version != m_search.requestedVersion )
+        {
+            m_search.requestedQuery = m_search.buffer;
+            m_search.requestedVersion = version;
+            m_searchResults.request(
+                [query = m_search.buffer, version, &gmod, &locations = m_vis.locations( version ), index]() {
+                    return search( query, version, gmod, locations, index );
+                } );
+        }
 
-        const auto& locations = m_vis.locations( version );
-        auto parsedPath = GmodPath::fromShortPath( pathBuffer, gmod, locations );
+        // While typing, the previous query's results stay until the new ones are in
+        const auto results = m_searchResults.latest();
+        if( !results || results->version != version )
+        {
+            ImGui::TextDisabled( "Searching..." );
+            return;
+        }
+        if( results->query != m_search.buffer )
+        {
+            ImGui::TextDisabled( "Searching..." );
+        }
 
-        if( parsedPath.has_value() )
+        if( results->parsedPath.has_value() )
         {
             // Valid path found - show the target node
-            const GmodNode& targetNode = parsedPath->node();
+            const GmodPath& parsedPath = *results->parsedPath;
+            const GmodNode& targetNode = parsedPath.node();
 
             ImGui::PushID( "path_search" );
 
             // Build and display the full canonical path
-            std::vector<const GmodNode*> fullPath;
-            for( const auto& parent : parsedPath->parents() )
+            FrameVector<const GmodNode*> fullPath( FrameArena::resource() );
+            for( const auto& parent : parsedPath.parents() )
             {
                 fullPath.push_back( &parent );
             }
@@ -712,14 +696,7 @@ namespace nfx::vista
 
                 if( clickedNode )
                 {
-                    m_navigation.selectedNodeCode = clickedNodeCode;
-                    m_navigation.scrollToNode = true;
-                    m_navigation.expandSelectedNode = true;
-                    notifyNodeSelection( clickedNode, version );
-                    if( m_onChanged )
-                    {
-                        m_onChanged();
-                    }
+                    revealNode( *clickedNode, version );
                 }
             }
 
@@ -727,160 +704,62 @@ namespace nfx::vista
             return;
         }
 
-        // Search through all nodes and render results
         int resultCount = 0;
 
-        for( const auto& [code, node] : gmod )
+        for( const SearchMatch& match : results->matches )
         {
-            // Convert node code and name to lowercase for comparison
-            std::string codeLower = std::string( node.code() );
-            std::transform( codeLower.begin(), codeLower.end(), codeLower.begin(), ::tolower );
-
-            std::string nameLower = std::string( node.metadata().name() );
-            std::transform( nameLower.begin(), nameLower.end(), nameLower.begin(), ::tolower );
+            const GmodNode& node = *match.node;
+            resultCount++;
 
-            std::string commonNameLower;
-            if( node.metadata().commonName().has_value() )
-            {
-                commonNameLower = std::string( node.metadata().commonName().value() );
-                std::transform( commonNameLower.begin(), commonNameLower.end(), commonNameLower.begin(), ::tolower );
-            }
+            ImGui::PushID( resultCount );
 
-            // Check if search term matches code or name
-            // Code: contains search term (incremental search: "c10" matches "C101", "C1082", etc.)
-            bool codeMatch = codeLower.find( searchLower ) != std::string::npos;
-            bool nameMatch = nameLower.find( searchLower ) != std::string::npos;
-            bool commonNameMatch = !commonNameLower.empty() && commonNameLower.find( searchLower ) != std::string::npos;
-
-            // Skip nodes ending with 'i' or 's' (individualizable/selections) from search results
-            // These are internal structure nodes, not actual items that can be referenced
-            std::string_view nodeCode = node.code();
-            bool isStructuralNode = !nodeCode.empty() && ( nodeCode.back() == 'i' || nodeCode.back() == 's' );
+            bool clicked = false;
+            const GmodNode* clickedNode = nullptr;
 
-            if( ( codeMatch || nameMatch || commonNameMatch ) && !isStructuralNode )
+            // Render path badges: last ASSET/PRODUCT FUNCTION LEAF, then the node itself
+            int badgeIndex = 0;
+            if( match.functionLeaf )
             {
-                resultCount++;
-
-                // Build canonical path - show only: last ASSET/PRODUCT FUNCTION LEAF + subsequent products
-                std::vector<const GmodNode*> displayPath;
-
-                // Find the last ASSET/PRODUCT FUNCTION LEAF in the path
-                const GmodNode* current = &node;
-                const GmodNode* lastFunctionLeaf = nullptr;
-
-                while( !current->parents().isEmpty() )
-                {
-                    const GmodNode* parent = current->parents()[0];
-                    if( parent->code() == "VE" )
-                        break;
-
-                    std::string_view code = parent->code();
-                    if( !code.empty() )
-                    {
-                        char lastChar = code.back();
-                        bool isStructural = ( lastChar == 'i' || lastChar == 's' );
-
-                        if( !isStructural && !parent->isProductSelection() )
-                        {
-                            std::string_view category = parent->metadata().category();
-                            std::string_view type = parent->metadata().type();
-
-                            bool isFunctionLeaf =
-                                ( category == "ASSET FUNCTION" || category == "PRODUCT FUNCTION" ) && type == "LEAF";
-
-                            if( isFunctionLeaf )
-                            {
-                                lastFunctionLeaf = parent;
-                            }
-                        }
-                    }
-                    current = parent;
-                }
-
-                // Build display path: [last function leaf] / [searched node]
-                if( lastFunctionLeaf != nullptr && lastFunctionLeaf != &node )
-                {
-                    displayPath.push_back( lastFunctionLeaf );
-                }
-
-                ImGui::PushID( resultCount );
-
-                bool clicked = false;
-                std::string clickedNodeCode;
-
-                // Render path badges
-                int badgeIndex = 0;
-                for( const GmodNode* pathNode : displayPath )
-                {
-                    ImGui::PushID( badgeIndex++ );
-                    if( renderBadge( *pathNode ) )
-                    {
-                        clicked = true;
-                        clickedNodeCode = std::string( pathNode->code() );
-                    }
-                    ImGui::PopID();
-                    ImGui::SameLine();
-                }
-
-                // Render current node badge
-                ImGui::PushID( badgeIndex );
-                if( renderBadge( node ) )
+                ImGui::PushID( badgeIndex++ );
+                if( renderBadge( *match.functionLeaf ) )
                 {
                     clicked = true;
-                    clickedNodeCode = std::string( node.code() );
+                    clickedNode = match.functionLeaf;
                 }
                 ImGui::PopID();
-
                 ImGui::SameLine();
+            }
 
-                // Display name as selectable
-                const char* displayName = node.metadata().commonName().has_value()
-                                              ? node.metadata().commonName().value().data()
-                                              : node.metadata().name().data();
+            // Render current node badge
+            ImGui::PushID( badgeIndex );
+            if( renderBadge( node ) )
+            {
+                clicked = true;
+                clickedNode = &node;
+            }
+            ImGui::PopID();
 
-                if( ImGui::Selectable( displayName, false ) )
-                {
-                    clicked = true;
-                    clickedNodeCode = std::string( node.code() );
-                }
+            ImGui::SameLine();
 
-                // Handle click: navigate to node in tree
-                if( clicked )
-                {
-                    // Find the clicked node
-                    const GmodNode* clickedNode = nullptr;
-                    if( clickedNodeCode == node.code() )
-                    {
-                        clickedNode = &node;
-                    }
-                    else
-                    {
-                        for( const GmodNode* pathNode : displayPath )
-                        {
-                            if( pathNode->code() == clickedNodeCode )
-                            {
-                                clickedNode = pathNode;
-                                break;
-                            }
-                        }
-                    }
+            // Display name as selectable
+            const char* displayName = node.metadata().commonName().has_value()
+                                          ? node.metadata().commonName().value().data()
+                                          : node.metadata().name().data();
 
-                    if( clickedNode )
-                    {
-                        m_navigation.selectedNodeCode = clickedNodeCode;
-                        m_navigation.scrollToNode = true;
-                        m_navigation.expandSelectedNode = true;
-                        notifyNodeSelection( clickedNode, version );
-                        if( m_onChanged )
-                        {
-                            m_onChanged();
-                        }
-                    }
-                    // Don't close search - user must click outside
-                }
+            if( ImGui::Selectable( displayName, false ) )
+            {
+                clicked = true;
+                clickedNode = &node;
+            }
 
-                ImGui::PopID();
+            // Handle click: navigate to node in tree
+            if( clicked && clickedNode )
+            {
+                revealNode( *clickedNode, version );
+                // Don't close search - user must click outside
             }
+
+            ImGui::PopID();
         }
 
         if( resultCount == 0 )
@@ -889,7 +768,8 @@ namespace nfx::vista
         }
     }
 
-    void GmodViewer::renderSearchResultsOverlay( const Gmod& gmod, VisVersion version )
+    void GmodViewer::renderSearchResultsOverlay(
+        const Gmod& gmod, const std::shared_ptr<const GmodIndex>& index, VisVersion version )
     {
         // Position the overlay window below the search box
         ImVec2 overlayPos = ImVec2( m_search.boxPos.x, m_search.boxPos.y + m_search.boxSize.y );
@@ -910,7 +790,7 @@ namespace nfx::vista
                 ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoDocking | ImGuiWindowFlags_NoFocusOnAppearing |
                 ImGuiWindowFlags_AlwaysAutoResize );
 
-        renderSearchResults( gmod, version );
+        renderSearchResults( gmod, index, version );
 
         // Track if overlay is hovered to keep it open
         m_search.overlayHovered = ImGui::IsWindowHovered( ImGuiHoveredFlags_AllowWhenBlockedByActiveItem );
@@ -0,0 +1,473 @@
+#include "panels/LocalIdBatch.h"
+#include "config/Theme.h"
+#include "diagnostics/AllocationTracker.h"
+#include "diagnostics/Tracer.h"
+
+#include <imgui.h>
+#include <misc/cpp/imgui_stdlib.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+
+using namespace dnv::vista::sdk;
+
+namespace nfx::vista
+{
+    namespace
+    {
+        constexpr size_t k_chunkRows = 256;       ///< Rows per worker task
+        constexpr size_t k_maxRows = 1'000'000;   ///< Generate is disabled above this
+        constexpr int k_maxNumber = 999'999;      ///< Location numbers are clamped to 1..this
+        constexpr float k_tableHeight = 320.0f;
+
+        std::string firstError( const ParsingErrors& errors, const char* fallback )
+        {
+            for( const auto& [type, message] : errors )
+            {
+                return message;
+            }
+            return fallback;
+        }
+
+        /**
+         * @brief Add or remove a location code from a selection string
+         */
+        void toggleCode( std::string& selected, char code )
+        {
+            const auto pos = selected.find( code );
+            if( pos == std::string::npos )
+            {
+                selected += code;
+            }
+            else
+            {
+                selected.erase( pos, 1 );
+            }
+        }
+
+        void writeCsvField( std::ofstream& f, std::string_view value )
+        {
+            f << '"';
+            for( char c : value )
+            {
+                if( c == '"' )
+                {
+                    f << '"';
+                }
+                f << c;
+            }
+            f << '"';
+        }
+    } // namespace
+
+    LocalIdBatch::LocalIdBatch( const VIS& vis, ThreadPool& workers )
+        : m_vis{ vis },
+          m_workers{ workers }
+    {
+    }
+
+    void LocalIdBatch::generateRows( const VIS& vis, Job& job, size_t begin, size_t end )
+    {
+        auto trace = Tracer::scope( "LocalIdBatch::generateRows", "batch" );
+
+        const auto& gmod = vis.gmod( job.version );
+        const auto& locations = vis.locations( job.version );
+        const size_t perNumber = job.sides.size() * job.verticals.size();
+
+        for( size_t i = begin; i < end && !job.cancelled.load( std::memory_order_relaxed ); ++i )
+        {
+            const int number = job.numbers[i / perNumber];
+            const char side = job.sides[( i / job.verticals.size() ) % job.sides.size()];
+            const char vertical = job.verticals[i % job.verticals.size()];
+            Row& row = job.rows[i];
+
+            auto allocations = AllocationTracker::scope( AllocationTag::Sdk );
+            try
+            {
+                auto lb = LocationBuilder::create( locations );
+                if( number > 0 )
+                {
+                    lb = std::move( lb ).withNumber( number );
+                }
+                if( side != 0 )
+                {
+                    lb = std::move( lb ).withSide( side );
+                }
+                if( vertical != 0 )
+                {
+                    lb = std::move( lb ).withVertical( vertical );
+                }
+                row.location = lb.build().value();
+            }
+            catch( const std::exception& e )
+            {
+                row.error = std::string( "Invalid location: " ) + e.what();
+                continue;
+            }
+
+            const auto located = applyLocation( *job.primary, row.location );
+            if( !located.has_value() )
+            {
+                row.error = "No individualizable node for the location";
+                continue;
+            }
+
+            ParsingErrors pathErrors;
+            const std::string& pathText = *located;
+            const auto path = GmodPath::fromShortPath( pathText, gmod, locations, pathErrors );
+            if( !path.has_value() )
+            {
+                row.localId = pathText;
+                row.error = firstError( pathErrors, "Invalid path" );
+                continue;
+            }
+
+            LocalIdParts parts{ job.version };
+            parts.primaryText = pathText;
+            parts.primary = &*path;
+            parts.secondaryText = job.secondaryText;
+            parts.secondary = job.secondary ? &*job.secondary : nullptr;
+            parts.verbose = job.verbose;
+            parts.tags = &job.tags;
+            composeLocalId( parts, job.codebooks.get(), row.localId );
+
+            ParsingErrors idErrors;
+            if( !LocalId::fromString( row.localId, idErrors ).has_value() )
+            {
+                row.error = firstError( idErrors, "Invalid LocalId" );
+            }
+        }
+
+        job.completed.fetch_add( end - begin, std::memory_order_relaxed );
+    }
+
+    size_t LocalIdBatch::numberRange() const
+    {
+        // Widened: the difference of two ints may not fit one
+        const int64_t count = int64_t{ m_spec.numberTo } - int64_t{ m_spec.numberFrom } + 1;
+        return count > 0 ? static_cast<size_t>( count ) : 0;
+    }
+
+    void LocalIdBatch::startJob( const LocalIdParts& parts, const std::shared_ptr<const CodebookCache>& codebooks )
+    {
+        if( m_job )
+        {
+            m_job->cancelled.store( true, std::memory_order_relaxed );
+        }
+
+        auto job = std::make_shared<Job>();
+        job->version = parts.version;
+        job->primary = *parts.primary;
+        job->secondaryText = parts.secondaryText;
+        if( parts.secondary )
+        {
+            job->secondary = *parts.secondary;
+        }
+        job->verbose = parts.verbose;
+        job->tags = *parts.tags;
+        job->codebooks = codebooks;
+
+        if( m_spec.useNumbers )
+        {
+            const size_t numberCount = numberRange();
+            job->numbers.reserve( numberCount );
+            for( size_t i = 0; i < numberCount; ++i )
+            {
+                job->numbers.push_back( m_spec.numberFrom + static_cast<int>( i ) );
+            }
+        }
+        else
+        {
+            job->numbers.push_back( 0 );
+        }
+        job->sides = m_spec.sides.empty() ? std::string( 1, '\0' ) : m_spec.sides;
+        job->verticals = m_spec.verticals.empty() ? std::string( 1, '\0' ) : m_spec.verticals;
+
+        const size_t count = job->numbers.size() * job->sides.size() * job->verticals.size();
+        job->rows.resize( count );
+        job->start = std::chrono::steady_clock::now();
+        m_job = job;
+        m_output.reset();
+
+        auto notifier = m_onChanged;
+        m_workers.parallelFor(
+            count,
+            k_chunkRows,
+            [job, notifier, &vis = m_vis]( size_t begin, size_t end ) {
+                generateRows( vis, *job, begin, end );
+                if( notifier )
+                {
+                    notifier(); // Progress
+                }
+            },
+            [job, notifier]() {
+                job->validCount = static_cast<size_t>( std::count_if(
+                    job->rows.begin(), job->rows.end(), []( const Row& row ) { return row.error.empty(); } ) );
+                job->seconds =
+                    std::chrono::duration<double>( std::chrono::steady_clock::now() - job->start ).count();
+                job->finished.store( true, std::memory_order_release );
+                if( notifier )
+                {
+                    notifier();
+                }
+            } );
+    }
+
+    void LocalIdBatch::render( const LocalIdParts& parts, const std::shared_ptr<const CodebookCache>& codebooks )
+    {
+        renderSpec( parts.version );
+
+        const size_t numberCount = m_spec.useNumbers ? numberRange() : 1;
+        const size_t count =
+            numberCount * std::max<size_t>( m_spec.sides.size(), 1 ) * std::max<size_t>( m_spec.verticals.size(), 1 );
+        const bool anyComponent = m_spec.useNumbers || !m_spec.sides.empty() || !m_spec.verticals.empty();
+
+        ImGui::Spacing();
+        const bool locatable = parts.primary && !parts.primary->individualizableSets().empty();
+        const bool canGenerate = locatable && parts.tags && anyComponent && count > 0 && count <= k_maxRows;
+        ImGui::BeginDisabled( !canGenerate );
+        if( ImGui::Button( "Generate" ) )
+        {
+            startJob( parts, codebooks );
+        }
+        ImGui::EndDisabled();
+        ImGui::SameLine();
+        if( !parts.primary )
+        {
+            ImGui::TextDisabled( "Needs a valid primary path" );
+        }
+        else if( !locatable )
+        {
+            ImGui::TextDisabled( "The primary path has no individualizable node to locate" );
+        }
+        else if( count > k_maxRows )
+        {
+            ImGui::TextDisabled( "%zu combinations, at most %zu", count, k_maxRows );
+        }
+        else
+        {
+            ImGui::TextDisabled( "%zu combinations", anyComponent ? count : 0 );
+        }
+
+        if( !m_job )
+        {
+            return;
+        }
+
+        const Job& job = *m_job;
+        if( !job.finished.load( std::memory_order_acquire ) )
+        {
+            const size_t completed = job.completed.load( std::memory_order_relaxed );
+            const float fraction = static_cast<float>( completed ) / static_cast<float>( job.rows.size() );
+            ImGui::ProgressBar( fraction, ImVec2( -110.0f, 0.0f ) );
+            ImGui::SameLine();
+            if( ImGui::Button( "Cancel", ImVec2( 100, 0 ) ) )
+            {
+                m_job->cancelled.store( true, std::memory_order_relaxed );
+            }
+            return;
+        }
+
+        if( job.cancelled.load( std::memory_order_relaxed ) )
+        {
+            ImGui::TextDisabled( "Cancelled" );
+            return;
+        }
+
+        renderResults( job );
+    }
+
+    void LocalIdBatch::renderSpec( VisVersion version )
+    {
+        ImGui::Checkbox( "Numbers##batch", &m_spec.useNumbers );
+        if( m_spec.useNumbers )
+        {
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth( 60 );
+            ImGui::InputInt( "##batchFrom", &m_spec.numberFrom, 0, 0 );
+            ImGui::SameLine();
+            ImGui::TextUnformatted( "to" );
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth( 60 );
+            ImGui::InputInt( "##batchTo", &m_spec.numberTo, 0, 0 );
+            m_spec.numberFrom = std::clamp( m_spec.numberFrom, 1, k_maxNumber );
+            m_spec.numberTo = std::clamp( m_spec.numberTo, m_spec.numberFrom, k_maxNumber );
+        }
+
+        // One checkbox per code of the group, selected codes kept in order of selection
+        const auto& groups = m_vis.locations( version ).groups();
+        auto renderCodes = [&groups]( const char* label, LocationGroup group, std::string& selected ) {
+            ImGui::TextUnformatted( label );
+            auto it = groups.find( group );
+            if( it == groups.end() )
+            {
+                return;
+            }
+            ImGui::PushID( label );
+            for( const auto& relLoc : it->second )
+            {
+                const char code[2] = { relLoc.code(), '\0' };
+                bool checked = selected.find( relLoc.code() ) != std::string::npos;
+                ImGui::SameLine();
+                if( ImGui::Checkbox( code, &checked ) )
+                {
+                    toggleCode( selected, relLoc.code() );
+                }
+                if( ImGui::IsItemHovered() )
+                {
+                    ImGui::SetTooltip( "%.*s", static_cast<int>( relLoc.name().size() ), relLoc.name().data() );
+                }
+            }
+            ImGui::PopID();
+        };
+
+        renderCodes( "Sides:", LocationGroup::Side, m_spec.sides );
+        renderCodes( "Verticals:", LocationGroup::Vertical, m_spec.verticals );
+    }
+
+    void LocalIdBatch::renderResults( const Job& job )
+    {
+        const double rate = job.seconds > 0.0 ? static_cast<double>( job.rows.size() ) / job.seconds : 0.0;
+        ImGui::PushStyleColor(
+            ImGuiCol_Text, job.validCount == job.rows.size() ? Theme::TextSuccess : Theme::TextWarning );
+        ImGui::Text( "%zu / %zu valid", job.validCount, job.rows.size() );
+        ImGui::PopStyleColor();
+        ImGui::SameLine();
+        ImGui::TextDisabled( "in %.2f s (%.0f/s)", job.seconds, rate );
+
+        // The clipboard belongs to the UI thread: a finished copy is handed over here
+        const bool outputBusy = m_output && !m_output->finished.load( std::memory_order_acquire );
+        if( m_output && !outputBusy && !m_output->clipboard.empty() )
+        {
+            ImGui::SetClipboardText( m_output->clipboard.c_str() );
+            std::string().swap( m_output->clipboard );
+        }
+
+        ImGui::BeginDisabled( outputBusy );
+        if( ImGui::Button( "Copy valid" ) )
+        {
+            startOutput( true );
+        }
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth( 240 );
+        ImGui::InputText( "##batchExportPath", &m_spec.exportPath );
+        ImGui::SameLine();
+        if( ImGui::Button( "Export CSV" ) )
+        {
+            startOutput( false );
+        }
+        ImGui::EndDisabled();
+        if( outputBusy )
+        {
+            ImGui::SameLine();
+            ImGui::TextDisabled( "Writing..." );
+        }
+        else if( m_output )
+        {
+            ImGui::SameLine();
+            ImGui::TextDisabled( "%s", m_output->status.c_str() );
+        }
+
+        constexpr ImGuiTableFlags tableFlags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV |
+                                               ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+        if( !ImGui::BeginTable( "##batchRows", 3, tableFlags, ImVec2( 0.0f, k_tableHeight ) ) )
+        {
+            return;
+        }
+
+        ImGui::TableSetupScrollFreeze( 0, 1 );
+        ImGui::TableSetupColumn( "Location", ImGuiTableColumnFlags_WidthFixed, 80.0f );
+        ImGui::TableSetupColumn( "LocalId", ImGuiTableColumnFlags_WidthStretch, 3.0f );
+        ImGui::TableSetupColumn( "Status", ImGuiTableColumnFlags_WidthStretch, 1.0f );
+        ImGui::TableHeadersRow();
+
+        // Only the visible rows are submitted: tens of thousands of rows cost the same as a screenful
+        ImGuiListClipper clipper;
+        clipper.Begin( static_cast<int>( job.rows.size() ) );
+        while( clipper.Step() )
+        {
+            for( int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i )
+            {
+                const Row& row = job.rows[static_cast<size_t>( i )];
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex( 0 );
+                ImGui::TextUnformatted( row.location.c_str() );
+                ImGui::TableSetColumnIndex( 1 );
+                ImGui::TextUnformatted( row.localId.c_str() );
+                ImGui::TableSetColumnIndex( 2 );
+                if( row.error.empty() )
+                {
+                    ImGui::PushStyleColor( ImGuiCol_Text, Theme::TextSuccess );
+                    ImGui::TextUnformatted( "Valid" );
+                }
+                else
+                {
+                    ImGui::PushStyleColor( ImGuiCol_Text, Theme::TextError );
+                    ImGui::TextUnformatted( row.error.c_str() );
+                }
+                ImGui::PopStyleColor();
+            }
+        }
+
+        ImGui::EndTable();
+    }
+
+    void LocalIdBatch::startOutput( bool toClipboard )
+    {
+        auto output = std::make_shared<Output>();
+        m_output = output;
+
+        m_workers.submit( [job = m_job, output, toClipboard, path = m_spec.exportPath, notifier = m_onChanged]() {
+            auto trace = Tracer::scope( "LocalIdBatch::output", "batch" );
+            auto allocations = AllocationTracker::scope( AllocationTag::LocalIdBuilder );
+
+            if( toClipboard )
+            {
+                size_t count = 0;
+                for( const auto& row : job->rows )
+                {
+                    if( row.error.empty() )
+                    {
+                        output->clipboard += row.localId;
+                        output->clipboard += '\n';
+                        ++count;
+                    }
+                }
+                output->status = "Copied " + std::to_string( count ) + " LocalIds";
+            }
+            else
+            {
+                output->status = exportCsv( *job, path ) ? "Exported to " + path : "Cannot write " + path;
+            }
+
+            output->finished.store( true, std::memory_order_release );
+            if( notifier )
+            {
+                notifier();
+            }
+        } );
+    }
+
+    bool LocalIdBatch::exportCsv( const Job& job, const std::string& path )
+    {
+        std::ofstream f( path );
+        if( !f )
+        {
+            return false;
+        }
+
+        f << "location,localId,valid,error\n";
+        for( const auto& row : job.rows )
+        {
+            writeCsvField( f, row.location );
+            f << ',';
+            writeCsvField( f, row.localId );
+            f << ',' << ( row.error.empty() ? "true" : "false" ) << ',';
+            writeCsvField( f, row.error );
+            f << '\n';
+        }
+        return static_cast<bool>( f );
+    }
+} // namespace nfx::vista
@@ -1,53 +1,437 @@
 #include "panels/LocalIdBuilder.h"
+#include "FrameArena.h"
+#include "Hash.h"
+#include "LocalIdText.h"
+#include "VersionStore.h"
 #include "config/Theme.h"
+#include "diagnostics/AllocationTracker.h"
+#include "diagnostics/Tracer.h"
 
 #include <misc/cpp/imgui_stdlib.h>
 
 #include <algorithm>
 #include <cctype>
+#include <cfloat>
 
 using namespace dnv::vista::sdk;
 
 namespace nfx::vista
 {
-    LocalIdBuilder::LocalIdBuilder( const VIS& vis )
-        : m_vis{ vis }
+    namespace
     {
-        const auto latestVersion = m_vis.latest();
-        const auto& codebooks = m_vis.codebooks( latestVersion );
+        constexpr double k_parseDebounceSeconds = 0.15; ///< Typing pause before a path is parsed
+        constexpr int k_suggestionRows = 8;             ///< Visible rows of the autocomplete list
+
+        /**
+         * @brief Where a relative location code goes in a location: after the number, letters in
+         *        alphabetical order as the SDK writes and requires them
+         */
+        size_t locationInsertPoint( std::string_view location, char code )
+        {
+            size_t pos = 0;
+            while( pos < location.size() &&
+                   ( std::isdigit( static_cast<unsigned char>( location[pos] ) ) || location[pos] < code ) )
+            {
+                ++pos;
+            }
+            return pos;
+        }
+
+        /**
+         * @brief Locate the segment (or its location part) a failed short path parse is about
+         * @details Prefers a segment whose node code or location is unknown, then one whose code an error
+         *          message quotes. Parent/child mismatches between known nodes have no single culprit.
+         */
+        std::pair<size_t, size_t> findErrorSpan(
+            std::string_view text, const Gmod& gmod, const Locations& locations, const ParsingErrors& errors )
+        {
+            std::pair<size_t, size_t> quoted{ 0, 0 };
+
+            for( size_t begin = 0; begin < text.size(); )
+            {
+                size_t end = text.find( '/', begin );
+                if( end == std::string_view::npos )
+                {
+                    end = text.size();
+                }
+
+                const auto segment = text.substr( begin, end - begin );
+                const auto dash = segment.find( '-' );
+                const auto code = segment.substr( 0, dash );
+
+                if( code.empty() || !gmod.node( code ).has_value() )
+                {
+                    return { begin, begin + code.size() };
+                }
+                if( dash != std::string_view::npos )
+                {
+                    ParsingErrors locationErrors;
+                    if( !locations.fromString( segment.substr( dash + 1 ), locationErrors ).has_value() )
+                    {
+                        return { begin + dash + 1, end };
+                    }
+                }
+
+                if( quoted.first == quoted.second )
+                {
+                    for( const auto& [type, message] : errors )
+                    {
+                        if( message.find( code ) != std::string::npos )
+                        {
+                            quoted = { begin, end };
+                            break;
+                        }
+                    }
+                }
+
+                begin = end + 1;
+            }
+
+            return quoted;
+        }
+    } // namespace
+
+    LocalIdBuilder::LocalIdBuilder( const VIS& vis, const VersionStore& versions, ThreadPool& workers )
+        : m_vis{ vis },
+          m_versions{ versions },
+          m_primaryParse{ workers },
+          m_secondaryParse{ workers },
+          m_validation{ workers },
+          m_batch{ vis, workers }
+    {
+    }
+
+    void LocalIdBuilder::syncPath(
+        AsyncSnapshot<PathParse>& parse,
+        const std::string& text,
+        bool& dirty,
+        bool& pending,
+        std::optional<GmodPath>& path,
+        VisVersion version )
+    {
+        if( dirty )
+        {
+            // The previous path must not be used with the new text while the parse runs
+            path = std::nullopt;
+            pending = !text.empty();
+            if( pending )
+            {
+                const auto& gmod = m_vis.gmod( version );
+                const auto& locations = m_vis.locations( version );
+                parse.request( [text, &gmod, &locations]() {
+                    auto trace = Tracer::scope( "GmodPath::fromShortPath", "parse" );
+                    auto allocations = AllocationTracker::scope( AllocationTag::Sdk );
+                    ParsingErrors errors;
+                    PathParse result{ text, GmodPath::fromShortPath( text, gmod, locations, errors ), {}, {} };
+                    if( !result.path.has_value() )
+                    {
+                        for( const auto& [type, message] : errors )
+                        {
+                            result.errors.push_back( message );
+                        }
+                        result.errorSpan = findErrorSpan( text, gmod, locations, errors );
+                    }
+                    return result;
+                } );
+            }
+            dirty = false;
+        }
+
+        if( pending )
+        {
+            // Results for older texts are ignored, their successor is queued behind them
+            const auto parsed = parse.latest();
+            if( parsed && parsed->text == text )
+            {
+                path = parsed->path;
+                pending = false;
+            }
+        }
+    }
+
+    void LocalIdBuilder::updateSuggestions( PathSuggestions& suggestions, const std::string& text, VisVersion version )
+    {
+        if( suggestions.text == text && suggestions.table == m_shortPaths.get() )
+        {
+            return;
+        }
+
+        suggestions.text = text;
+        suggestions.table = m_shortPaths.get();
+        suggestions.nodes = {};
+        suggestions.locations.clear();
+        if( !m_shortPaths || !m_gmodIndex )
+        {
+            return;
+        }
+
+        const std::string_view path = text;
+        const size_t slash = path.rfind( '/' );
+        suggestions.segmentBegin = slash == std::string_view::npos ? 0 : slash + 1;
+        const auto segment = path.substr( suggestions.segmentBegin );
+
+        // The segment before the one being typed decides what may follow, its location aside
+        uint32_t origin = m_shortPaths->root();
+        if( slash != std::string_view::npos )
+        {
+            auto previous = path.substr( 0, slash );
+            const size_t previousSlash = previous.rfind( '/' );
+            previous = previous.substr( previousSlash == std::string_view::npos ? 0 : previousSlash + 1 );
+            const auto code = m_gmodIndex->indexOf( previous.substr( 0, previous.find( '-' ) ) );
+            if( !code )
+            {
+                return;
+            }
+            origin = *code;
+        }
+
+        const size_t dash = segment.find( '-' );
+        if( dash == std::string_view::npos )
+        {
+            suggestions.nodes = m_shortPaths->next( *m_gmodIndex, origin, segment );
+            return;
+        }
+
+        // Typing a location: the relative codes not used yet, numbers are free-form
+        const auto node = m_gmodIndex->indexOf( segment.substr( 0, dash ) );
+        if( !node || !m_gmodIndex->node( *node ).isIndividualizable( true ) )
+        {
+            return;
+        }
+
+        // One code per group: groups the typed location already uses offer nothing more, and a candidate
+        // the SDK would still reject (an unknown character typed before it) is dropped
+        const auto typed = segment.substr( dash + 1 );
+        const Locations& locations = m_vis.locations( version );
+        std::string candidate;
+        for( const auto& [group, relatives] : locations.groups() )
+        {
+            const bool used = std::any_of( relatives.begin(), relatives.end(), [typed]( const auto& relative ) {
+                return typed.find( relative.code() ) != std::string_view::npos;
+            } );
+            if( group == LocationGroup::Number || used )
+            {
+                continue;
+            }
+            for( const auto& relative : relatives )
+            {
+                candidate.assign( typed );
+                candidate.insert( locationInsertPoint( typed, relative.code() ), 1, relative.code() );
+                if( locations.fromString( candidate ).has_value() )
+                {
+                    suggestions.locations.emplace_back( relative.code(), relative.name() );
+                }
+            }
+        }
+    }
+
+    bool LocalIdBuilder::renderSuggestions(
+        const char* id, PathSuggestions& suggestions, std::string& text, bool inputActive )
+    {
+        const size_t rowCount = suggestions.nodes.size() + suggestions.locations.size();
+        if( ( !inputActive && !suggestions.hovered ) || rowCount == 0 )
+        {
+            suggestions.hovered = false;
+            return false;
+        }
+
+        const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+        const float height = static_cast<float>( std::min<size_t>( rowCount, k_suggestionRows ) ) * rowHeight +
+                             ImGui::GetStyle().WindowPadding.y * 2.0f;
+
+        bool accepted = false;
+        ImGui::BeginChild( id, ImVec2( -FLT_MIN, height ), true );
+
+        FrameString label( FrameArena::resource() ); // Reused for every row
+        ImGuiListClipper clipper;
+        clipper.Begin( static_cast<int>( rowCount ), rowHeight );
+        while( clipper.Step() )
+        {
+            for( int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row )
+            {
+                const auto index = static_cast<size_t>( row );
+                ImGui::PushID( row );
+                if( index < suggestions.nodes.size() )
+                {
+                    const auto& node = m_gmodIndex->node( suggestions.nodes[index] );
+                    const auto name = node.metadata().name();
+                    label.assign( node.code() );
+                    label += "  ";
+                    label += name;
+                    if( ImGui::Selectable( label.c_str() ) )
+                    {
+                        text.resize( suggestions.segmentBegin );
+                        text += node.code();
+                        accepted = true;
+                    }
+                }
+                else
+                {
+                    const auto& [code, name] = suggestions.locations[index - suggestions.nodes.size()];
+                    label.assign( 1, code );
+                    label += "  ";
+                    label += name;
+                    if( ImGui::Selectable( label.c_str() ) )
+                    {
+                        const size_t locationBegin = text.find( '-', suggestions.segmentBegin ) + 1;
+                        const auto location = std::string_view( text ).substr( locationBegin );
+                        text.insert( locationBegin + locationInsertPoint( location, code ), 1, code );
+                        accepted = true;
+                    }
+                }
+                ImGui::PopID();
+            }
+        }
 
-        for( const auto& codebookName : { CodebookName::Quantity,
-                                          CodebookName::Content,
-                                          CodebookName::Position,
-                                          CodebookName::Calculation,
-                                          CodebookName::State,
-                                          CodebookName::Command,
-                                          CodebookName::Type,
-                                          CodebookName::Detail } )
+        ImGui::EndChild();
+        suggestions.hovered = !accepted && ImGui::IsItemHovered( ImGuiHoveredFlags_AllowWhenBlockedByActiveItem );
+        return accepted;
+    }
+
+    bool LocalIdBuilder::debounceEdit( bool edited, bool committed, double& editTime )
+    {
+        if( committed )
         {
-            const auto& cb = codebooks[codebookName];
-            const auto& standardValues = cb.standardValues();
+            editTime = -1.0;
+            return true;
+        }
 
-            std::vector<std::string> sorted;
-            sorted.reserve( standardValues.size() );
-            for( const auto& value : standardValues )
+        const double now = ImGui::GetTime();
+        if( edited )
+        {
+            // Each keystroke restarts the delay: no parse is queued while the user is still typing
+            editTime = now;
+            if( m_onWakeRequest )
             {
-                sorted.push_back( value );
+                m_onWakeRequest( k_parseDebounceSeconds );
             }
-            std::sort( sorted.begin(), sorted.end() );
+            return false;
+        }
 
-            m_codebookCache[codebookName] = std::move( sorted );
+        if( editTime >= 0.0 && now - editTime >= k_parseDebounceSeconds )
+        {
+            editTime = -1.0;
+            return true;
         }
+        return false;
+    }
 
-        m_cachedVersion = latestVersion;
+    void LocalIdBuilder::renderPathStatus(
+        const AsyncSnapshot<PathParse>& parse,
+        const std::string& text,
+        bool pending,
+        const std::optional<GmodPath>& path )
+    {
+        if( text.empty() )
+        {
+            return;
+        }
+
+        if( pending )
+        {
+            ImGui::TextDisabled( "Parsing..." );
+        }
+        else if( path.has_value() )
+        {
+            ImGui::PushStyleColor( ImGuiCol_Text, Theme::TextSuccess );
+            ImGui::TextWrapped( "[OK] %s", path->node().metadata().name().data() );
+            ImGui::PopStyleColor();
+        }
+        else
+        {
+            ImGui::PushStyleColor( ImGuiCol_Text, Theme::TextError );
+            ImGui::Text( "[X] Invalid" );
+            ImGui::PopStyleColor();
+
+            // Not pending: the latest parse is the one of this text
+            const auto parsed = parse.latest();
+            if( !parsed || parsed->text != text )
+            {
+                return;
+            }
+
+            // The path with the offending segment in the error colour
+            const auto [spanBegin, spanEnd] = parsed->errorSpan;
+            if( spanBegin < spanEnd && spanEnd <= text.size() )
+            {
+                const char* begin = text.c_str();
+                ImGui::SameLine();
+                ImGui::TextUnformatted( begin, begin + spanBegin );
+                ImGui::SameLine( 0.0f, 0.0f );
+                ImGui::PushStyleColor( ImGuiCol_Text, Theme::TextError );
+                ImGui::TextUnformatted( begin + spanBegin, begin + spanEnd );
+                ImGui::PopStyleColor();
+                ImGui::SameLine( 0.0f, 0.0f );
+                ImGui::TextUnformatted( begin + spanEnd, begin + text.size() );
+            }
+
+            for( const auto& message : parsed->errors )
+            {
+                ImGui::TextDisabled( "%s", message.c_str() );
+            }
+        }
+    }
+
+    void LocalIdBuilder::setMetadataTag( CodebookName name, std::string value )
+    {
+        switch( name )
+        {
+            case CodebookName::Quantity:
+                m_state.tags.quantity = std::move( value );
+                break;
+            case CodebookName::Content:
+                m_state.tags.content = std::move( value );
+                break;
+            case CodebookName::Position:
+                m_state.tags.position = std::move( value );
+                break;
+            case CodebookName::Calculation:
+                m_state.tags.calculation = std::move( value );
+                break;
+            case CodebookName::State:
+                m_state.tags.state = std::move( value );
+                break;
+            case CodebookName::Command:
+                m_state.tags.command = std::move( value );
+                break;
+            case CodebookName::Type:
+                m_state.tags.type = std::move( value );
+                break;
+            case CodebookName::Detail:
+                m_state.tags.detail = std::move( value );
+                break;
+            default:
+                return;
+        }
+
+        if( m_onChanged )
+        {
+            m_onChanged();
+        }
     }
 
-    void LocalIdBuilder::render( VisVersion version )
+    bool LocalIdBuilder::render( VisVersion version )
     {
+        auto trace = Tracer::scope( "LocalIdBuilder::render", "ui" );
+
         if( !ImGui::Begin( "LocalId Builder" ) )
         {
             ImGui::End();
-            return;
+            return false;
+        }
+
+        // A version flip only swaps pointers: every version's tables were built when it loaded
+        if( const auto* entry = m_versions.find( version ) )
+        {
+            if( entry->codebookCache != m_codebooks )
+            {
+                m_codebooks = entry->codebookCache;
+            }
+            if( entry->shortPaths != m_shortPaths )
+            {
+                m_gmodIndex = entry->index;
+                m_shortPaths = entry->shortPaths;
+            }
         }
 
         ImGui::TextWrapped( "Build VIS Local IDs by selecting Gmod paths and metadata tags." );
@@ -64,22 +448,33 @@ namespace nfx::vista
         renderLocationSection( version );
         ImGui::Spacing();
 
-        renderMetadataSection( version );
+        renderMetadataSection();
         ImGui::Spacing();
 
         renderOutputSection( version );
+        ImGui::Spacing();
+
+        renderBatchSection( version );
 
         ImGui::End();
+        return true;
     }
 
     void LocalIdBuilder::renderPrimaryItemSection( VisVersion version )
     {
         ImGui::SeparatorText( "Primary Item (Required)" );
 
-        ImGui::InputTextWithHint(
+        const bool edited = ImGui::InputTextWithHint(
             "##primaryPath", "Enter Gmod path (e.g., 411.1-1P or 612.21/C701.13)", &m_state.primaryPath );
+        const bool inputActive = ImGui::IsItemActive();
 
-        if( ImGui::IsItemDeactivatedAfterEdit() )
+        // Parsed as you type, once typing pauses or the field is left
+        if( edited )
+        {
+            m_state.primaryPathOpt = std::nullopt;
+            m_state.primaryPathPending = !m_state.primaryPath.empty();
+        }
+        if( debounceEdit( edited, ImGui::IsItemDeactivatedAfterEdit(), m_state.primaryEditTime ) )
         {
             m_state.primaryPathDirty = true;
             if( m_onChanged )
@@ -103,39 +498,29 @@ namespace nfx::vista
             }
         }
 
-        // Reparse only when dirty
-        if( m_state.primaryPathDirty )
+        // Completion of the segment being typed, from the version's transition table
+        updateSuggestions( m_primarySuggestions, m_state.primaryPath, version );
+        if( renderSuggestions( "##primarySuggestions", m_primarySuggestions, m_state.primaryPath, inputActive ) )
         {
-            const auto& gmod = m_vis.gmod( version );
-            const auto& locations = m_vis.locations( version );
-            ParsingErrors tempErrors;
-            if( !m_state.primaryPath.empty() )
-            {
-                m_state.primaryPathOpt = GmodPath::fromShortPath( m_state.primaryPath, gmod, locations, tempErrors );
-            }
-            else
+            m_state.primaryEditTime = -1.0;
+            m_state.primaryPathDirty = true;
+            if( m_onChanged )
             {
-                m_state.primaryPathOpt = std::nullopt;
+                m_onChanged();
             }
-            m_state.primaryPathDirty = false;
         }
 
+        // Reparse only when dirty
+        syncPath(
+            m_primaryParse,
+            m_state.primaryPath,
+            m_state.primaryPathDirty,
+            m_state.primaryPathPending,
+            m_state.primaryPathOpt,
+            version );
+
         // Validation display
-        if( !m_state.primaryPath.empty() )
-        {
-            if( m_state.primaryPathOpt.has_value() )
-            {
-                ImGui::PushStyleColor( ImGuiCol_Text, Theme::TextSuccess );
-                ImGui::TextWrapped( "[OK] %s", m_state.primaryPathOpt->node().metadata().name().data() );
-                ImGui::PopStyleColor();
-            }
-            else
-            {
-                ImGui::PushStyleColor( ImGuiCol_Text, Theme::TextError );
-                ImGui::Text( "[X] Invalid" );
-                ImGui::PopStyleColor();
-            }
-        }
+        renderPathStatus( m_primaryParse, m_state.primaryPath, m_state.primaryPathPending, m_state.primaryPathOpt );
 
         ImGui::TextDisabled( "Examples: 411.1, 411.1-1P, 612.21/C701.13/S93" );
     }
@@ -151,9 +536,16 @@ namespace nfx::vista
             return;
         }
 
-        ImGui::InputTextWithHint( "##secondaryPath", "Enter secondary Gmod path", &m_state.secondaryPath );
+        const bool edited =
+            ImGui::InputTextWithHint( "##secondaryPath", "Enter secondary Gmod path", &m_state.secondaryPath );
+        const bool inputActive = ImGui::IsItemActive();
 
-        if( ImGui::IsItemDeactivatedAfterEdit() )
+        if( edited )
+        {
+            m_state.secondaryPathOpt = std::nullopt;
+            m_state.secondaryPathPending = !m_state.secondaryPath.empty();
+        }
+        if( debounceEdit( edited, ImGui::IsItemDeactivatedAfterEdit(), m_state.secondaryEditTime ) )
         {
             m_state.secondaryPathDirty = true;
             if( m_onChanged )
@@ -176,142 +568,171 @@ namespace nfx::vista
             }
         }
 
-        // Reparse only when dirty
-        if( m_state.secondaryPathDirty )
+        // Completion of the segment being typed, from the version's transition table
+        updateSuggestions( m_secondarySuggestions, m_state.secondaryPath, version );
+        if( renderSuggestions( "##secondarySuggestions", m_secondarySuggestions, m_state.secondaryPath, inputActive ) )
         {
-            const auto& gmod = m_vis.gmod( version );
-            const auto& locations = m_vis.locations( version );
-            ParsingErrors tempErrors;
-            if( !m_state.secondaryPath.empty() )
-            {
-                m_state.secondaryPathOpt =
-                    GmodPath::fromShortPath( m_state.secondaryPath, gmod, locations, tempErrors );
-            }
-            else
+            m_state.secondaryEditTime = -1.0;
+            m_state.secondaryPathDirty = true;
+            if( m_onChanged )
             {
-                m_state.secondaryPathOpt = std::nullopt;
+                m_onChanged();
             }
-            m_state.secondaryPathDirty = false;
         }
 
+        // Reparse only when dirty
+        syncPath(
+            m_secondaryParse,
+            m_state.secondaryPath,
+            m_state.secondaryPathDirty,
+            m_state.secondaryPathPending,
+            m_state.secondaryPathOpt,
+            version );
+
         // Validation display
-        if( !m_state.secondaryPath.empty() )
+        renderPathStatus(
+            m_secondaryParse, m_state.secondaryPath, m_state.secondaryPathPending, m_state.secondaryPathOpt );
+    }
+
+    void LocalIdBuilder::updateLocation( VisVersion version )
+    {
+        if( m_locationButtons.version != version )
         {
-            if( m_state.secondaryPathOpt.has_value() )
-            {
-                ImGui::PushStyleColor( ImGuiCol_Text, Theme::TextSuccess );
-                ImGui::TextWrapped( "[OK] %s", m_state.secondaryPathOpt->node().metadata().name().data() );
-                ImGui::PopStyleColor();
-            }
-            else
+            // Toggle labels only change with the version: formatted here instead of every frame
+            static constexpr std::pair<LocationGroup, const char*> k_groupIds[] = {
+                { LocationGroup::Side, "side" },
+                { LocationGroup::Vertical, "vert" },
+                { LocationGroup::Transverse, "trans" },
+                { LocationGroup::Longitudinal, "longi" },
+            };
+
+            m_locationButtons.groups.clear();
+            const auto& groups = m_vis.locations( version ).groups();
+            for( const auto& [group, id] : k_groupIds )
             {
-                ImGui::PushStyleColor( ImGuiCol_Text, Theme::TextError );
-                ImGui::Text( "[X] Invalid" );
-                ImGui::PopStyleColor();
+                auto it = groups.find( group );
+                if( it == groups.end() )
+                {
+                    continue;
+                }
+
+                auto& buttons = m_locationButtons.groups[group];
+                for( const auto& relLoc : it->second )
+                {
+                    std::string label( 1, relLoc.code() );
+                    label += "  ";
+                    label += relLoc.name();
+                    label += "##";
+                    label += id;
+                    buttons.push_back( LocationButton{ relLoc.code(), std::move( label ) } );
+                }
             }
+            m_locationButtons.version = version;
         }
-    }
 
-    void LocalIdBuilder::renderLocationSection( VisVersion version )
-    {
-        if( !ImGui::CollapsingHeader( "Location (Optional)" ) )
+        const LocationKey key{ version,
+                               m_state.locationNumber,
+                               m_state.locationSide,
+                               m_state.locationVertical,
+                               m_state.locationTransverse,
+                               m_state.locationLong };
+        if( m_location.key == key )
+        {
+            return;
+        }
+        m_location.key = key;
+        m_location.value.clear();
+        m_location.hasAnyComponent = key.number > 0 || key.side != 0 || key.vertical != 0 || key.transverse != 0 ||
+                                     key.longitudinal != 0;
+        if( !m_location.hasAnyComponent )
         {
             return;
         }
-
-        const auto& locations = m_vis.locations( version );
 
         // Build current location string using LocationBuilder
-        std::string builtLocation;
-        bool hasAnyComponent = false;
-
         try
         {
-            auto lb = LocationBuilder::create( locations );
+            auto trace = Tracer::scope( "LocationBuilder::build", "ui" );
+            auto allocations = AllocationTracker::scope( AllocationTag::Sdk );
+            auto lb = LocationBuilder::create( m_vis.locations( version ) );
 
-            if( m_state.locationNumber > 0 )
+            if( key.number > 0 )
             {
-                lb = std::move( lb ).withNumber( m_state.locationNumber );
-                hasAnyComponent = true;
+                lb = std::move( lb ).withNumber( key.number );
             }
-            if( m_state.locationSide != 0 )
+            if( key.side != 0 )
             {
-                lb = std::move( lb ).withSide( m_state.locationSide );
-                hasAnyComponent = true;
+                lb = std::move( lb ).withSide( key.side );
             }
-            if( m_state.locationVertical != 0 )
+            if( key.vertical != 0 )
             {
-                lb = std::move( lb ).withVertical( m_state.locationVertical );
-                hasAnyComponent = true;
+                lb = std::move( lb ).withVertical( key.vertical );
             }
-            if( m_state.locationTransverse != 0 )
+            if( key.transverse != 0 )
             {
-                lb = std::move( lb ).withTransverse( m_state.locationTransverse );
-                hasAnyComponent = true;
+                lb = std::move( lb ).withTransverse( key.transverse );
             }
-            if( m_state.locationLong != 0 )
+            if( key.longitudinal != 0 )
             {
-                lb = std::move( lb ).withLongitudinal( m_state.locationLong );
-                hasAnyComponent = true;
+                lb = std::move( lb ).withLongitudinal( key.longitudinal );
             }
 
-            if( hasAnyComponent )
-            {
-                builtLocation = lb.build().value();
-            }
+            m_location.value = lb.build().value();
         }
         catch( ... )
         {
-            builtLocation.clear();
+            m_location.value.clear();
         }
+    }
+
+    void LocalIdBuilder::renderLocationSection( VisVersion version )
+    {
+        if( !ImGui::CollapsingHeader( "Location (Optional)" ) )
+        {
+            return;
+        }
+
+        // Built and labelled once per distinct selection and version: an idle open section makes no SDK calls
+        updateLocation( version );
+        const std::string& builtLocation = m_location.value;
+        const bool hasAnyComponent = m_location.hasAnyComponent;
 
         // Helper: render a group of toggle buttons on a new indented line
         // Returns true if the value changed.
-        auto renderToggleGroup =
-            [&]( const char* label, char& stateVal, LocationGroup group, const char* btnSuffix, const char* clearId ) {
-                ImGui::Text( "%s:", label );
-                ImGui::Indent();
-                const auto& groups = locations.groups();
-                auto it = groups.find( group );
-                if( it != groups.end() )
+        auto renderToggleGroup = [&]( const char* label, char& stateVal, LocationGroup group, const char* clearId ) {
+            ImGui::Text( "%s:", label );
+            ImGui::Indent();
+            auto it = m_locationButtons.groups.find( group );
+            if( it != m_locationButtons.groups.end() )
+            {
+                for( const auto& button : it->second )
                 {
-                    for( const auto& relLoc : it->second )
+                    bool selected = ( stateVal == button.code );
+                    if( selected )
                     {
-                        bool selected = ( stateVal == relLoc.code() );
-                        if( selected )
-                        {
-                            ImGui::PushStyleColor( ImGuiCol_Button, ImGui::GetStyleColorVec4( ImGuiCol_ButtonActive ) );
-                        }
-                        char btnLabel[64];
-                        snprintf(
-                            btnLabel,
-                            sizeof( btnLabel ),
-                            "%c  %.*s##%s",
-                            relLoc.code(),
-                            static_cast<int>( relLoc.name().size() ),
-                            relLoc.name().data(),
-                            btnSuffix );
-                        if( ImGui::Button( btnLabel ) )
-                        {
-                            stateVal = selected ? 0 : relLoc.code();
-                        }
-                        if( selected )
-                        {
-                            ImGui::PopStyleColor();
-                        }
-                        ImGui::SameLine();
+                        ImGui::PushStyleColor( ImGuiCol_Button, ImGui::GetStyleColorVec4( ImGuiCol_ButtonActive ) );
                     }
-                }
-                if( stateVal != 0 )
-                {
-                    if( ImGui::SmallButton( clearId ) )
+                    if( ImGui::Button( button.label.c_str() ) )
                     {
-                        stateVal = 0;
+                        stateVal = selected ? 0 : button.code;
                     }
+                    if( selected )
+                    {
+                        ImGui::PopStyleColor();
+                    }
+                    ImGui::SameLine();
                 }
-                ImGui::Unindent();
-                ImGui::Spacing();
-            };
+            }
+            if( stateVal != 0 )
+            {
+                if( ImGui::SmallButton( clearId ) )
+                {
+                    stateVal = 0;
+                }
+            }
+            ImGui::Unindent();
+            ImGui::Spacing();
+        };
 
         // --- Number ---
         ImGui::Text( "Number:" );
@@ -336,17 +757,16 @@ namespace nfx::vista
         ImGui::Spacing();
 
         // --- Side / Vertical / Transverse / Longitudinal ---
-        renderToggleGroup( "Side", m_state.locationSide, LocationGroup::Side, "side", "x##locSide" );
-        renderToggleGroup( "Vertical", m_state.locationVertical, LocationGroup::Vertical, "vert", "x##locVert" );
-        renderToggleGroup(
-            "Transverse", m_state.locationTransverse, LocationGroup::Transverse, "trans", "x##locTrans" );
-        renderToggleGroup( "Longitudinal", m_state.locationLong, LocationGroup::Longitudinal, "longi", "x##locLong" );
+        renderToggleGroup( "Side", m_state.locationSide, LocationGroup::Side, "x##locSide" );
+        renderToggleGroup( "Vertical", m_state.locationVertical, LocationGroup::Vertical, "x##locVert" );
+        renderToggleGroup( "Transverse", m_state.locationTransverse, LocationGroup::Transverse, "x##locTrans" );
+        renderToggleGroup( "Longitudinal", m_state.locationLong, LocationGroup::Longitudinal, "x##locLong" );
 
         ImGui::Separator();
         ImGui::Spacing();
 
         // Apply location to the correct individualizable node in the path using the SDK
-        auto applyLocation = [&]( std::string& pathBuf, const std::optional<GmodPath>& cachedPath ) {
+        auto applyToPath = [&]( std::string& pathBuf, const std::optional<GmodPath>& cachedPath ) {
             if( !cachedPath.has_value() )
             {
                 // Can't parse — raw text fallback: put location on first segment
@@ -359,7 +779,10 @@ namespace nfx::vista
                 {
                     firstSeg = firstSeg.substr( 0, dashPos );
                 }
-                pathBuf = firstSeg + "-" + builtLocation + rest;
+                pathBuf = firstSeg;
+                pathBuf += '-';
+                pathBuf += builtLocation;
+                pathBuf += rest;
                 if( m_onChanged )
                 {
                     m_onChanged();
@@ -367,65 +790,12 @@ namespace nfx::vista
                 return;
             }
 
-            // Get the clean path string (no locations) using the SDK
-            std::string cleanPath = cachedPath->withoutLocations().toString();
-
-            // Find the first individualizable set to know which segment gets the location
-            auto sets = cachedPath->individualizableSets();
-
-            std::string newPath;
-            if( sets.empty() )
+            auto located = nfx::vista::applyLocation( *cachedPath, builtLocation );
+            if( !located.has_value() )
             {
-                // No individualizable set: just use the clean path as-is (no location applicable)
-                newPath = cleanPath;
+                return; // No individualizable node: the path is left as typed
             }
-            else
-            {
-                // targetIdx is a fullPath index. Find what short-path segment it maps to.
-                // Build a mapping: fullPath index -> short-path segment index (0-based)
-                int shortSegIdx = 0; // which segment in cleanPath gets the location
-                int shortSeg = 0;
-                const GmodPath& constPath = *cachedPath;
-                for( size_t i = 0; i < constPath.length(); ++i )
-                {
-                    const auto& n = constPath[i];
-                    if( !n.isLeafNode() && i != constPath.length() - 1 )
-                    {
-                        continue;
-                    }
-                    if( (int)i == sets[0].nodeIndices().front() )
-                    {
-                        shortSegIdx = shortSeg;
-                        break;
-                    }
-                    shortSeg++;
-                }
-
-                // Split cleanPath by '/', insert location on shortSegIdx-th segment
-                std::string_view remaining( cleanPath );
-                int segN = 0;
-                while( !remaining.empty() )
-                {
-                    auto slash = remaining.find( '/' );
-                    std::string_view seg =
-                        ( slash == std::string_view::npos ) ? remaining : remaining.substr( 0, slash );
-
-                    if( !newPath.empty() )
-                        newPath += '/';
-                    newPath += seg;
-                    if( segN == shortSegIdx )
-                    {
-                        newPath += '-';
-                        newPath += builtLocation;
-                    }
-
-                    remaining =
-                        ( slash == std::string_view::npos ) ? std::string_view{} : remaining.substr( slash + 1 );
-                    segN++;
-                }
-            }
-
-            pathBuf = newPath;
+            pathBuf = std::move( *located );
             if( m_onChanged )
             {
                 m_onChanged();
@@ -481,6 +851,12 @@ namespace nfx::vista
 
             ImGui::PopStyleColor();
         }
+        else if( hasAnyComponent )
+        {
+            ImGui::PushStyleColor( ImGuiCol_Text, Theme::TextError );
+            ImGui::Text( "Invalid location" );
+            ImGui::PopStyleColor();
+        }
         else
         {
             ImGui::TextDisabled( "(no location)" );
@@ -495,7 +871,7 @@ namespace nfx::vista
             {
                 if( !m_state.primaryPath.empty() )
                 {
-                    applyLocation( m_state.primaryPath, m_state.primaryPathOpt );
+                    applyToPath( m_state.primaryPath, m_state.primaryPathOpt );
                     m_state.primaryPathDirty = true;
                 }
             }
@@ -505,7 +881,7 @@ namespace nfx::vista
                 ImGui::SameLine();
                 if( ImGui::Button( "Apply to Secondary" ) )
                 {
-                    applyLocation( m_state.secondaryPath, m_state.secondaryPathOpt );
+                    applyToPath( m_state.secondaryPath, m_state.secondaryPathOpt );
                     m_state.secondaryPathDirty = true;
                 }
             }
@@ -524,228 +900,130 @@ namespace nfx::vista
         }
     }
 
-    void LocalIdBuilder::renderMetadataSection( VisVersion version )
+    void LocalIdBuilder::renderMetadataSection()
     {
         ImGui::SeparatorText( "Metadata Tags" );
 
-        // Rebuild codebook cache if version changed
-        if( m_cachedVersion.value() != version )
-        {
-            m_codebookCache.clear();
-            const auto& codebooks = m_vis.codebooks( version );
-
-            for( const auto& codebookName : { CodebookName::Quantity,
-                                              CodebookName::Content,
-                                              CodebookName::Position,
-                                              CodebookName::Calculation,
-                                              CodebookName::State,
-                                              CodebookName::Command,
-                                              CodebookName::Type,
-                                              CodebookName::Detail } )
-            {
-                const auto& cb = codebooks[codebookName];
-                const auto& standardValues = cb.standardValues();
-
-                std::vector<std::string> sorted;
-                sorted.reserve( standardValues.size() );
-                for( const auto& value : standardValues )
-                    sorted.push_back( value );
-                std::sort( sorted.begin(), sorted.end() );
-
-                m_codebookCache[codebookName] = std::move( sorted );
-            }
-
-            m_cachedVersion = version;
-        }
-
         ImGui::Columns( 2, "metadata", false );
 
         // Column 1
-        renderMetadataInput( "##quantity", "Quantity", m_state.quantity, CodebookName::Quantity );
+        renderMetadataInput( "##quantity", "Quantity", m_state.tags.quantity, CodebookName::Quantity );
         ImGui::Spacing();
-        renderMetadataInput( "##content", "Content", m_state.content, CodebookName::Content );
+        renderMetadataInput( "##content", "Content", m_state.tags.content, CodebookName::Content );
         ImGui::Spacing();
-        renderMetadataInput( "##position", "Position", m_state.position, CodebookName::Position );
+        renderMetadataInput( "##position", "Position", m_state.tags.position, CodebookName::Position );
         ImGui::Spacing();
-        renderMetadataInput( "##calculation", "Calculation", m_state.calculation, CodebookName::Calculation );
+        renderMetadataInput( "##calculation", "Calculation", m_state.tags.calculation, CodebookName::Calculation );
 
         ImGui::NextColumn();
 
         // Column 2
-        renderMetadataInput( "##state", "State", m_state.state, CodebookName::State );
+        renderMetadataInput( "##state", "State", m_state.tags.state, CodebookName::State );
         ImGui::Spacing();
-        renderMetadataInput( "##command", "Command", m_state.command, CodebookName::Command );
+        renderMetadataInput( "##command", "Command", m_state.tags.command, CodebookName::Command );
         ImGui::Spacing();
-        renderMetadataInput( "##type", "Type", m_state.type, CodebookName::Type );
+        renderMetadataInput( "##type", "Type", m_state.tags.type, CodebookName::Type );
         ImGui::Spacing();
 
         ImGui::TextDisabled( "Detail" );
         ImGui::SetNextItemWidth( ImGui::GetContentRegionAvail().x );
-        ImGui::InputTextWithHint( "##detail", "Free text...", &m_state.detail );
+        ImGui::InputTextWithHint( "##detail", "Free text...", &m_state.tags.detail );
 
         ImGui::Columns( 1 );
     }
 
-    void LocalIdBuilder::renderOutputSection( VisVersion version )
+    uint64_t LocalIdBuilder::outputFingerprint( VisVersion version ) const
     {
-        ImGui::SeparatorText( "Generated LocalId" );
-
-        // Checkbox for verbose mode
-        ImGui::Checkbox( "Verbose mode (include common names)", &m_state.verboseMode );
-        ImGui::SameLine();
-        ImGui::TextDisabled( "(?)" );
-        if( ImGui::IsItemHovered() )
-        {
-            ImGui::SetTooltip( "Include human-readable node names in the LocalId" );
-        }
-
-        m_state.generatedLocalId.clear();
-        m_state.errors = ParsingErrors();
-
-        const auto& codebooks = m_vis.codebooks( version );
-
-        // Helper lambda to add metadata tag with correct separator (- for standard, ~ for custom)
-        // Detail always uses '-' regardless of value
-        auto addMetadataTag =
-            [&codebooks]( std::string& str, const char* prefix, const std::string& value, CodebookName codebookName ) {
-                bool isCustom = false;
-
-                if( codebookName != CodebookName::Detail )
-                {
-                    const auto& codebook = codebooks[codebookName];
-                    const auto& standardValues = codebook.standardValues();
-
-                    isCustom = true;
-                    for( const auto& standardValue : standardValues )
-                    {
-                        if( standardValue == value )
-                        {
-                            isCustom = false;
-                            break;
-                        }
-                    }
-                }
-
-                str += '/';
-                str += prefix;
-                str += ( isCustom ? '~' : '-' );
-                str += value;
-            };
-
-        // Use cached parsed paths
-        const auto& primaryPathOpt = m_state.primaryPathOpt;
-        const auto& secondaryPathOpt = m_state.secondaryPathOpt;
-
-        // Build LocalId string
-        std::string localIdStr;
-
-        // Use SDK builder if all paths are valid (to support verbose mode)
-        if( primaryPathOpt.has_value() &&
-            ( !m_state.hasSecondaryItem || m_state.secondaryPath[0] == '\0' || secondaryPathOpt.has_value() ) )
+        // Parsed paths count by presence only: their text is hashed and a parse depends on nothing else.
+        // Location selections only reach the output once applied to the path text.
+        uint64_t h = hash::k_seed;
+        h = hash::mix( h, static_cast<uint64_t>( version ) );
+        h = hash::mix( h, m_state.verboseMode );
+        h = hash::mix( h, m_state.hasSecondaryItem );
+        h = hash::mix( h, m_state.primaryPathOpt.has_value() );
+        h = hash::mix( h, m_state.secondaryPathOpt.has_value() );
+        h = hash::string( h, m_state.primaryPath );
+        h = hash::string( h, m_state.secondaryPath );
+
+        for( const auto* tag : { &m_state.tags.quantity,
+                                 &m_state.tags.content,
+                                 &m_state.tags.position,
+                                 &m_state.tags.calculation,
+                                 &m_state.tags.state,
+                                 &m_state.tags.command,
+                                 &m_state.tags.type,
+                                 &m_state.tags.detail } )
         {
-            auto builder = dnv::vista::sdk::LocalIdBuilder::create( version ).withVerboseMode( m_state.verboseMode );
-            builder = std::move( builder ).withPrimaryItem( *primaryPathOpt );
-
-            if( secondaryPathOpt.has_value() )
-            {
-                builder = std::move( builder ).withSecondaryItem( *secondaryPathOpt );
-            }
-
-            localIdStr = builder.toString();
+            h = hash::string( h, *tag );
         }
-        else
-        {
-            // Build manually if any path is invalid
-            localIdStr = "/dnv-v2/vis-";
-            localIdStr += VisVersions::toString( version );
-
-            if( m_state.primaryPath[0] != '\0' )
-            {
-                localIdStr += '/';
-                localIdStr += m_state.primaryPath;
-            }
 
-            if( m_state.hasSecondaryItem && m_state.secondaryPath[0] != '\0' )
-            {
-                localIdStr += "/sec/";
-                localIdStr += m_state.secondaryPath;
-            }
-        }
-
-        // Add metadata section
-        bool hasMetadata = false;
-        std::string metadataStr;
-
-        if( !m_state.quantity.empty() )
-        {
-            addMetadataTag( metadataStr, "qty", m_state.quantity, CodebookName::Quantity );
-            hasMetadata = true;
-        }
-
-        if( !m_state.content.empty() )
-        {
-            addMetadataTag( metadataStr, "cnt", m_state.content, CodebookName::Content );
-            hasMetadata = true;
-        }
+        return h;
+    }
 
-        if( !m_state.calculation.empty() )
+    LocalIdParts LocalIdBuilder::currentParts( VisVersion version ) const
+    {
+        LocalIdParts parts{ version };
+        parts.primaryText = m_state.primaryPath;
+        parts.primary = m_state.primaryPathOpt ? &*m_state.primaryPathOpt : nullptr;
+        if( m_state.hasSecondaryItem )
         {
-            addMetadataTag( metadataStr, "calc", m_state.calculation, CodebookName::Calculation );
-            hasMetadata = true;
+            parts.secondaryText = m_state.secondaryPath;
+            parts.secondary = m_state.secondaryPathOpt ? &*m_state.secondaryPathOpt : nullptr;
         }
+        parts.verbose = m_state.verboseMode;
+        parts.tags = &m_state.tags;
+        return parts;
+    }
 
-        if( !m_state.state.empty() )
-        {
-            addMetadataTag( metadataStr, "state", m_state.state, CodebookName::State );
-            hasMetadata = true;
-        }
+    void LocalIdBuilder::generateLocalId( VisVersion version )
+    {
+        auto trace = Tracer::scope( "LocalIdBuilder::generateLocalId", "ui" );
 
-        if( !m_state.command.empty() )
-        {
-            addMetadataTag( metadataStr, "cmd", m_state.command, CodebookName::Command );
-            hasMetadata = true;
-        }
+        // Keeps its capacity across rebuilds
+        composeLocalId( currentParts( version ), m_codebooks.get(), m_state.generatedLocalId );
 
-        if( !m_state.type.empty() )
+        // Validate using SDK's fromString() to get detailed errors, on a worker and once per distinct LocalId
+        if( m_state.generatedLocalId != m_state.requestedValidation )
         {
-            addMetadataTag( metadataStr, "type", m_state.type, CodebookName::Type );
-            hasMetadata = true;
+            m_state.requestedValidation = m_state.generatedLocalId;
+            if( !m_state.generatedLocalId.empty() )
+            {
+                m_validation.request( [localId = m_state.generatedLocalId]() {
+                    auto parse = Tracer::scope( "LocalId::fromString", "parse" );
+                    auto allocations = AllocationTracker::scope( AllocationTag::Sdk );
+                    Validation validation{ localId, {} };
+                    (void)LocalId::fromString( validation.localId, validation.errors );
+                    return validation;
+                } );
+            }
         }
+    }
 
-        if( !m_state.position.empty() )
-        {
-            addMetadataTag( metadataStr, "pos", m_state.position, CodebookName::Position );
-            hasMetadata = true;
-        }
+    void LocalIdBuilder::renderOutputSection( VisVersion version )
+    {
+        ImGui::SeparatorText( "Generated LocalId" );
 
-        if( !m_state.detail.empty() )
+        // Checkbox for verbose mode
+        ImGui::Checkbox( "Verbose mode (include common names)", &m_state.verboseMode );
+        ImGui::SameLine();
+        ImGui::TextDisabled( "(?)" );
+        if( ImGui::IsItemHovered() )
         {
-            addMetadataTag( metadataStr, "detail", m_state.detail, CodebookName::Detail );
-            hasMetadata = true;
+            ImGui::SetTooltip( "Include human-readable node names in the LocalId" );
         }
 
-        // Add /meta section if not already present
-        if( m_state.primaryPath[0] != '\0' )
+        // Rebuilt only when an input changed: idle frames do no SDK work
+        const uint64_t fingerprint = outputFingerprint( version );
+        if( m_state.outputFingerprint != fingerprint )
         {
-            // Check if /meta is already in the string (from SDK builder)
-            if( localIdStr.find( "/meta" ) == std::string::npos )
-            {
-                localIdStr += "/meta";
-            }
-
-            if( hasMetadata )
-            {
-                localIdStr += metadataStr;
-            }
+            m_state.outputFingerprint = fingerprint;
+            generateLocalId( version );
         }
 
-        m_state.generatedLocalId = localIdStr;
-
-        // Validate using SDK's fromString() to get detailed errors
-        if( !m_state.generatedLocalId.empty() )
-        {
-            (void)LocalId::fromString( m_state.generatedLocalId, m_state.errors );
-        }
+        // Errors of the LocalId on screen, nullptr until its validation is published
+        const auto validation = m_validation.latest();
+        const ParsingErrors* errors =
+            validation && validation->localId == m_state.generatedLocalId ? &validation->errors : nullptr;
 
         ImGui::Spacing(); // LocalId in a read-only input field (always present)
         ImGui::PushItemWidth( -220 );
@@ -772,20 +1050,29 @@ namespace nfx::vista
         ImGui::Spacing();
 
         // Show validation status
-        if( m_state.errors.hasErrors() )
+        if( m_state.generatedLocalId.empty() )
+        {
+            return;
+        }
+
+        if( !errors )
+        {
+            ImGui::TextDisabled( "Validating..." );
+        }
+        else if( errors->hasErrors() )
         {
             ImGui::PushStyleColor( ImGuiCol_Text, Theme::TextError );
             ImGui::Text( "Invalid Local ID" );
             ImGui::Spacing();
             ImGui::Indent();
-            for( const auto& [type, message] : m_state.errors )
+            for( const auto& [type, message] : *errors )
             {
                 ImGui::TextWrapped( "%s", message.c_str() );
             }
             ImGui::Unindent();
             ImGui::PopStyleColor();
         }
-        else if( !m_state.generatedLocalId.empty() )
+        else
         {
             ImGui::PushStyleColor( ImGuiCol_Text, Theme::TextSuccess );
             ImGui::Text( "Valid LocalId" );
@@ -793,6 +1080,16 @@ namespace nfx::vista
         }
     }
 
+    void LocalIdBuilder::renderBatchSection( VisVersion version )
+    {
+        if( !ImGui::CollapsingHeader( "Batch (Optional)" ) )
+        {
+            return;
+        }
+
+        m_batch.render( currentParts( version ), m_codebooks );
+    }
+
     void LocalIdBuilder::renderMetadataInput(
         const char* id, const char* label, std::string& value, CodebookName codebook )
     {
@@ -810,8 +1107,9 @@ namespace nfx::vista
         snprintf( buttonId, sizeof( buttonId ), "##btn_%s", id );
         bool openCombo = ImGui::ArrowButton( buttonId, ImGuiDir_Down );
 
-        // Get cached sorted codebook
-        const auto& cachedCodebook = m_codebookCache[codebook];
+        // Sorted once per version by the VersionStore
+        static const std::vector<std::string> s_noValues;
+        const auto& cachedCodebook = m_codebooks ? m_codebooks->sortedValues( codebook ) : s_noValues;
 
         // Open combo popup
         char popupId[48];
@@ -829,44 +1127,72 @@ namespace nfx::vista
         if( ImGui::BeginPopup( popupId ) )
         {
             // Get or create filter buffer for this combo
-            auto& filterStr = m_comboFilters[codebook];
+            auto& filter = m_comboFilters[codebook];
+            const bool appearing = ImGui::IsWindowAppearing();
 
             // Filter input at top
             ImGui::SetNextItemWidth( 300 );
-            ImGui::InputTextWithHint( "##filter", "Filter...", &filterStr );
+            ImGui::InputTextWithHint( "##filter", "Filter...", &filter.text );
+
+            // Filtered through the cache's lowercase corpus, once per filter text
+            if( filter.text != filter.appliedText || filter.cache != m_codebooks.get() )
+            {
+                filter.appliedText = filter.text;
+                filter.cache = m_codebooks.get();
+                filter.lowerText.clear();
+                for( char c : filter.text )
+                {
+                    filter.lowerText += static_cast<char>( std::tolower( static_cast<unsigned char>( c ) ) );
+                }
+                if( m_codebooks )
+                {
+                    m_codebooks->filter( codebook, filter.lowerText, filter.matches );
+                }
+                else
+                {
+                    filter.matches.clear();
+                }
+            }
 
             ImGui::Separator();
 
             // Filter and display items in a child window for scrolling
             ImGui::BeginChild( "##items", ImVec2( 300, 300 ), true );
 
-            // Filter and display items
-            std::string lowerFilter( filterStr );
-            std::transform( lowerFilter.begin(), lowerFilter.end(), lowerFilter.begin(), ::tolower );
+            // Unfiltered: every value, otherwise the cached matches
+            const bool filtered = !filter.text.empty();
+            const int rowCount = static_cast<int>( filtered ? filter.matches.size() : cachedCodebook.size() );
+            const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
 
-            for( const auto& item : cachedCodebook )
+            // Only visible rows are submitted: bring the current value into view when the popup opens
+            if( appearing && !filtered && !value.empty() )
             {
-                // Filter
-                if( !lowerFilter.empty() )
+                auto it = std::lower_bound( cachedCodebook.begin(), cachedCodebook.end(), value );
+                if( it != cachedCodebook.end() && *it == value )
                 {
-                    std::string lowerValue = item;
-                    std::transform( lowerValue.begin(), lowerValue.end(), lowerValue.begin(), ::tolower );
-                    if( lowerValue.find( lowerFilter ) == std::string::npos )
-                    {
-                        continue;
-                    }
+                    ImGui::SetScrollY( static_cast<float>( it - cachedCodebook.begin() ) * rowHeight );
                 }
+            }
 
-                bool isSelected = ( value == item );
-                if( ImGui::Selectable( item.c_str(), isSelected ) )
-                {
-                    value = item;
-                    m_comboFilters[codebook].clear();
-                    ImGui::CloseCurrentPopup();
-                }
-                if( isSelected )
+            ImGuiListClipper clipper;
+            clipper.Begin( rowCount, rowHeight );
+            while( clipper.Step() )
+            {
+                for( int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row )
                 {
-                    ImGui::SetItemDefaultFocus();
+                    const auto& item = cachedCodebook[filtered ? filter.matches[row] : static_cast<size_t>( row )];
+
+                    bool isSelected = ( value == item );
+                    if( ImGui::Selectable( item.c_str(), isSelected ) )
+                    {
+                        value = item;
+                        filter.text.clear();
+                        ImGui::CloseCurrentPopup();
+                    }
+                    if( isSelected )
+                    {
+                        ImGui::SetItemDefaultFocus();
+                    }
                 }
             }
 
@@ -878,7 +1204,7 @@ namespace nfx::vista
             // Clear filter when popup is closed
             if( !ImGui::IsPopupOpen( popupId ) )
             {
-                m_comboFilters[codebook].clear();
+                m_comboFilters[codebook].text.clear();
             }
         }
     }
@@ -0,0 +1,357 @@
+#include "panels/LocalIdInspector.h"
+#include "FrameArena.h"
+#include "LocalIdText.h"
+#include "config/Theme.h"
+#include "diagnostics/AllocationTracker.h"
+#include "diagnostics/Tracer.h"
+
+#include <imgui.h>
+#include <misc/cpp/imgui_stdlib.h>
+
+#include <fstream>
+#include <iterator>
+
+using namespace dnv::vista::sdk;
+
+namespace nfx::vista
+{
+    namespace
+    {
+        constexpr size_t k_chunkRows = 512; ///< Lines per worker task
+        constexpr float k_sourceHeight = 120.0f;
+
+        const GmodNode* resolveNode( const Gmod& gmod, const std::optional<GmodPath>& path )
+        {
+            if( !path.has_value() )
+            {
+                return nullptr;
+            }
+            return gmod.node( path->node().code() ).value_or( nullptr );
+        }
+
+        double secondsSince( std::chrono::steady_clock::time_point start )
+        {
+            return std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+        }
+    } // namespace
+
+    LocalIdInspector::LocalIdInspector( const VIS& vis, ThreadPool& workers )
+        : m_vis{ vis },
+          m_workers{ workers }
+    {
+    }
+
+    void LocalIdInspector::splitLines( Job& job )
+    {
+        auto trace = Tracer::scope( "LocalIdInspector::splitLines", "parse" );
+
+        // One row per line, viewing job.text: nothing is copied however large the paste
+        forEachLine( job.text, [&job]( std::string_view line, size_t lineNumber ) {
+            Row& row = job.rows.emplace_back();
+            row.line = line;
+            row.lineNumber = static_cast<uint32_t>( lineNumber );
+        } );
+    }
+
+    void LocalIdInspector::parseRows( const VIS& vis, Job& job, size_t begin, size_t end )
+    {
+        auto trace = Tracer::scope( "LocalIdInspector::parseRows", "parse" );
+        auto allocations = AllocationTracker::scope( AllocationTag::Sdk );
+
+        for( size_t i = begin; i < end && !job.cancelled.load( std::memory_order_relaxed ); ++i )
+        {
+            Row& row = job.rows[i];
+            ParsingErrors errors;
+            const auto localId = LocalId::fromString( row.line, errors );
+            if( localId.has_value() )
+            {
+                row.valid = true;
+                row.version = localId->visVersion();
+                const auto& gmod = vis.gmod( row.version );
+                row.primary = resolveNode( gmod, localId->primaryItem() );
+                row.secondary = resolveNode( gmod, localId->secondaryItem() );
+                continue;
+            }
+
+            for( const auto& [type, message] : errors )
+            {
+                if( !row.errors.empty() )
+                {
+                    row.errors += '\n';
+                }
+                row.errors += message;
+            }
+            if( row.errors.empty() )
+            {
+                row.errors = "Invalid LocalId";
+            }
+        }
+
+        job.completed.fetch_add( end - begin, std::memory_order_relaxed );
+    }
+
+    void LocalIdInspector::startJob( std::string text, std::string filePath )
+    {
+        if( m_job )
+        {
+            m_job->cancelled.store( true, std::memory_order_relaxed );
+        }
+
+        auto job = std::make_shared<Job>();
+        job->text = std::move( text );
+        job->filePath = std::move( filePath );
+        job->start = std::chrono::steady_clock::now();
+        m_job = job;
+
+        auto finish = [job, notifier = m_onChanged]() {
+            job->parseSeconds = secondsSince( job->start ) - job->splitSeconds;
+            for( size_t i = 0; i < job->rows.size(); ++i )
+            {
+                if( job->rows[i].valid )
+                {
+                    ++job->validCount;
+                }
+                else
+                {
+                    job->invalidRows.push_back( static_cast<uint32_t>( i ) );
+                }
+            }
+            job->finished.store( true, std::memory_order_release );
+            if( notifier )
+            {
+                notifier();
+            }
+        };
+
+        // Reading and splitting run on a worker too: a large file must not stall the frame that starts it
+        m_workers.submit( [job, finish, notifier = m_onChanged, &vis = m_vis, &workers = m_workers]() {
+            auto allocations = AllocationTracker::scope( AllocationTag::LocalIdInspector );
+
+            if( !job->filePath.empty() )
+            {
+                std::ifstream file( job->filePath, std::ios::binary );
+                if( !file )
+                {
+                    job->loadError = "Cannot read " + job->filePath;
+                    finish();
+                    return;
+                }
+                job->text.assign( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+            }
+
+            splitLines( *job );
+            job->splitSeconds = secondsSince( job->start );
+            job->total.store( job->rows.size(), std::memory_order_release );
+            if( job->rows.empty() )
+            {
+                finish();
+                return;
+            }
+
+            workers.parallelFor(
+                job->rows.size(),
+                k_chunkRows,
+                [job, notifier, &vis]( size_t begin, size_t end ) {
+                    parseRows( vis, *job, begin, end );
+                    if( notifier )
+                    {
+                        notifier(); // Progress
+                    }
+                },
+                finish );
+        } );
+    }
+
+    bool LocalIdInspector::render()
+    {
+        auto trace = Tracer::scope( "LocalIdInspector::render", "ui" );
+
+        if( !ImGui::Begin( "LocalId Inspector" ) )
+        {
+            ImGui::End();
+            return false;
+        }
+
+        renderSource();
+
+        if( m_job )
+        {
+            ImGui::Spacing();
+            const Job& job = *m_job;
+            if( !job.finished.load( std::memory_order_acquire ) )
+            {
+                const size_t total = job.total.load( std::memory_order_acquire );
+                const size_t completed = job.completed.load( std::memory_order_relaxed );
+                const float fraction = total > 0 ? static_cast<float>( completed ) / static_cast<float>( total ) : 0.0f;
+                ImGui::ProgressBar( fraction, ImVec2( -110.0f, 0.0f ), total > 0 ? nullptr : "Reading..." );
+                ImGui::SameLine();
+                if( ImGui::Button( "Cancel", ImVec2( 100, 0 ) ) )
+                {
+                    m_job->cancelled.store( true, std::memory_order_relaxed );
+                }
+            }
+            else if( !job.loadError.empty() )
+            {
+                ImGui::PushStyleColor( ImGuiCol_Text, Theme::TextError );
+                ImGui::TextUnformatted( job.loadError.c_str() );
+                ImGui::PopStyleColor();
+            }
+            else if( job.cancelled.load( std::memory_order_relaxed ) )
+            {
+                ImGui::TextDisabled( "Cancelled" );
+            }
+            else
+            {
+                renderResults( job );
+            }
+        }
+
+        ImGui::End();
+        return true;
+    }
+
+    void LocalIdInspector::renderSource()
+    {
+        ImGui::TextDisabled( "One LocalId per line" );
+        ImGui::InputTextMultiline( "##inspectText", &m_input.text, ImVec2( -1.0f, k_sourceHeight ) );
+
+        ImGui::BeginDisabled( m_input.text.empty() );
+        if( ImGui::Button( "Inspect" ) )
+        {
+            startJob( m_input.text, {} );
+        }
+        ImGui::EndDisabled();
+        ImGui::SameLine();
+
+        // Large pastes go straight to a job: the text box would lay out every line each frame
+        if( ImGui::Button( "Inspect Clipboard" ) )
+        {
+            if( const char* clipboard = ImGui::GetClipboardText() )
+            {
+                startJob( clipboard, {} );
+            }
+        }
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth( -110.0f );
+        ImGui::InputTextWithHint( "##inspectFile", "File path", &m_input.filePath );
+        ImGui::SameLine();
+        ImGui::BeginDisabled( m_input.filePath.empty() );
+        if( ImGui::Button( "Inspect File", ImVec2( 100, 0 ) ) )
+        {
+            startJob( {}, m_input.filePath );
+        }
+        ImGui::EndDisabled();
+    }
+
+    void LocalIdInspector::renderResults( const Job& job )
+    {
+        const size_t total = job.rows.size();
+        const double seconds = job.splitSeconds + job.parseSeconds;
+        const double linesPerSecond = job.parseSeconds > 0.0 ? static_cast<double>( total ) / job.parseSeconds : 0.0;
+        const double megabytesPerSecond =
+            seconds > 0.0 ? static_cast<double>( job.text.size() ) / ( 1024.0 * 1024.0 ) / seconds : 0.0;
+
+        ImGui::PushStyleColor( ImGuiCol_Text, job.validCount == total ? Theme::TextSuccess : Theme::TextWarning );
+        ImGui::Text( "%zu / %zu valid", job.validCount, total );
+        ImGui::PopStyleColor();
+        ImGui::SameLine();
+        ImGui::TextDisabled(
+            "%.0f lines/s, %.1f MB/s on %zu threads (split %.1f ms, parse %.1f ms)",
+            linesPerSecond,
+            megabytesPerSecond,
+            m_workers.threadCount(),
+            job.splitSeconds * 1000.0,
+            job.parseSeconds * 1000.0 );
+
+        ImGui::Checkbox( "Invalid only", &m_input.invalidOnly );
+
+        constexpr ImGuiTableFlags tableFlags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV |
+                                               ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+        if( !ImGui::BeginTable( "##inspectRows", 5, tableFlags ) )
+        {
+            return;
+        }
+
+        ImGui::TableSetupScrollFreeze( 0, 1 );
+        ImGui::TableSetupColumn( "Line", ImGuiTableColumnFlags_WidthFixed, 50.0f );
+        ImGui::TableSetupColumn( "LocalId", ImGuiTableColumnFlags_WidthStretch, 3.0f );
+        ImGui::TableSetupColumn( "Status", ImGuiTableColumnFlags_WidthStretch, 2.0f );
+        ImGui::TableSetupColumn( "Primary", ImGuiTableColumnFlags_WidthFixed, 70.0f );
+        ImGui::TableSetupColumn( "Secondary", ImGuiTableColumnFlags_WidthFixed, 70.0f );
+        ImGui::TableHeadersRow();
+
+        // Only the visible rows are submitted, and their text is drawn from the views into the source
+        const size_t shown = m_input.invalidOnly ? job.invalidRows.size() : total;
+        ImGuiListClipper clipper;
+        clipper.Begin( static_cast<int>( shown ) );
+        while( clipper.Step() )
+        {
+            for( int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i )
+            {
+                const size_t index =
+                    m_input.invalidOnly ? job.invalidRows[static_cast<size_t>( i )] : static_cast<size_t>( i );
+                const Row& row = job.rows[index];
+                ImGui::PushID( static_cast<int>( index ) );
+                ImGui::TableNextRow();
+
+                ImGui::TableSetColumnIndex( 0 );
+                ImGui::TextDisabled( "%u", row.lineNumber );
+
+                ImGui::TableSetColumnIndex( 1 );
+                ImGui::TextUnformatted( row.line.data(), row.line.data() + row.line.size() );
+
+                ImGui::TableSetColumnIndex( 2 );
+                if( row.valid )
+                {
+                    ImGui::PushStyleColor( ImGuiCol_Text, Theme::TextSuccess );
+                    ImGui::TextUnformatted( VisVersions::toString( row.version ).data() );
+                    ImGui::PopStyleColor();
+                }
+                else
+                {
+                    // First message in the cell, all of them on hover
+                    const size_t firstEnd = row.errors.find( '\n' );
+                    ImGui::PushStyleColor( ImGuiCol_Text, Theme::TextError );
+                    ImGui::TextUnformatted(
+                        row.errors.data(),
+                        row.errors.data() + ( firstEnd == std::string::npos ? row.errors.size() : firstEnd ) );
+                    ImGui::PopStyleColor();
+                    if( ImGui::IsItemHovered() )
+                    {
+                        ImGui::SetTooltip( "%s", row.errors.c_str() );
+                    }
+                }
+
+                ImGui::TableSetColumnIndex( 3 );
+                renderNodeLink( row.primary, row.version );
+                ImGui::TableSetColumnIndex( 4 );
+                renderNodeLink( row.secondary, row.version );
+
+                ImGui::PopID();
+            }
+        }
+
+        ImGui::EndTable();
+    }
+
+    void LocalIdInspector::renderNodeLink( const GmodNode* node, VisVersion version )
+    {
+        if( !node )
+        {
+            return;
+        }
+
+        const std::string_view code = node->code();
+        ImGui::PushID( node );
+        if( ImGui::SmallButton( FrameString( code, FrameArena::resource() ).c_str() ) && m_onNodeLink )
+        {
+            m_onNodeLink( *node, version );
+        }
+        if( ImGui::IsItemHovered() )
+        {
+            const std::string_view name = node->metadata().name();
+            ImGui::SetTooltip( "%.*s\nShow in Gmod Viewer", static_cast<int>( name.size() ), name.data() );
+        }
+        ImGui::PopID();
+    }
+} // namespace nfx::vista
@@ -7,6 +7,7 @@
 
 #include "panels/NodeDetails.h"
 #include "config/Theme.h"
+#include "diagnostics/Tracer.h"
 
 #include <imgui.h>
 
@@ -14,9 +15,15 @@ using namespace dnv::vista::sdk;
 
 namespace nfx::vista
 {
-    void NodeDetails::render()
+    bool NodeDetails::render()
     {
-        ImGui::Begin( "Node Details" );
+        auto trace = Tracer::scope( "NodeDetails::render", "ui" );
+
+        if( !ImGui::Begin( "Node Details" ) )
+        {
+            ImGui::End();
+            return false;
+        }
 
         if( !m_currentGmodPath.has_value() )
         {
@@ -24,12 +31,20 @@ namespace nfx::vista
             ImGui::Separator();
             ImGui::TextWrapped( "Click on a node in the Gmod Viewer to see its details here." );
             ImGui::End();
-            return;
+            return true;
         }
 
         const GmodPath& gmodPath = m_currentGmodPath.value();
         const GmodNode& node = gmodPath.node();
 
+        // Selections made while hidden are formatted once, when the panel is shown
+        if( m_pathStrings.dirty )
+        {
+            m_pathStrings.shortPath = gmodPath.toString();
+            m_pathStrings.fullPath = gmodPath.toFullPathString();
+            m_pathStrings.dirty = false;
+        }
+
         // Node header
         ImGui::PushStyleColor( ImGuiCol_Text, Theme::TextCode );
         ImGui::TextUnformatted( node.code().data() );
@@ -56,12 +71,12 @@ namespace nfx::vista
         ImGui::Text( "Short Path:" );
         ImGui::SameLine();
         ImGui::PushStyleColor( ImGuiCol_Text, Theme::TextPath );
-        ImGui::TextUnformatted( gmodPath.toString().c_str() );
+        ImGui::TextUnformatted( m_pathStrings.shortPath.c_str() );
         ImGui::PopStyleColor();
 
         ImGui::Text( "Full Path:" );
         ImGui::SameLine();
-        ImGui::TextDisabled( "%s", gmodPath.toFullPathString().c_str() );
+        ImGui::TextDisabled( "%s", m_pathStrings.fullPath.c_str() );
 
         ImGui::Spacing();
 
@@ -197,5 +212,6 @@ namespace nfx::vista
         }
 
         ImGui::End();
+        return true;
     }
 } // namespace nfx::vista
@@ -1,5 +1,6 @@
 #include "panels/ProjectManager.h"
 #include "config/Theme.h"
+#include "diagnostics/Tracer.h"
 
 #include <dnv/vista/sdk/ImoNumber.h>
 #include <dnv/vista/sdk/transport/ShipId.h>
@@ -12,7 +13,8 @@
 
 namespace nfx::vista
 {
-    ProjectManager::ProjectManager()
+    ProjectManager::ProjectManager( ThreadPool& workers )
+        : m_browserListing{ workers }
     {
         const auto dir = ProjectSerializer::defaultDir();
         m_saveAsPath = ( dir / "project.json" ).string();
@@ -21,22 +23,25 @@ namespace nfx::vista
         m_browserFileName = "project.json";
     }
 
-    void ProjectManager::refreshBrowserEntries()
+    ProjectManager::BrowserListing ProjectManager::listDirectory( const std::filesystem::path& directory )
     {
-        m_browserEntries.clear();
+        auto trace = Tracer::scope( "ProjectManager::listDirectory", "io" );
+
+        BrowserListing listing{ directory, {} };
+        auto& entries = listing.entries;
 
         std::error_code ec;
 
         // Add parent directory entry if not at root
-        if( m_browserCurrentDir.has_parent_path() && m_browserCurrentDir != m_browserCurrentDir.root_path() )
+        if( directory.has_parent_path() && directory != directory.root_path() )
         {
-            m_browserEntries.push_back( { "..", m_browserCurrentDir.parent_path(), true } );
+            entries.push_back( { "..", directory.parent_path(), true } );
         }
 
         std::vector<BrowserEntry> dirs;
         std::vector<BrowserEntry> files;
 
-        for( const auto& entry : std::filesystem::directory_iterator( m_browserCurrentDir, ec ) )
+        for( const auto& entry : std::filesystem::directory_iterator( directory, ec ) )
         {
             if( ec )
             {
@@ -68,13 +73,20 @@ namespace nfx::vista
 
         for( auto& d : dirs )
         {
-            m_browserEntries.push_back( std::move( d ) );
+            entries.push_back( std::move( d ) );
         }
         for( auto& f : files )
         {
-            m_browserEntries.push_back( std::move( f ) );
+            entries.push_back( std::move( f ) );
         }
 
+        return listing;
+    }
+
+    void ProjectManager::requestBrowserListing()
+    {
+        // Slow or remote directories must not stall the dialog: the listing is read on a worker
+        m_browserListing.request( [directory = m_browserCurrentDir]() { return listDirectory( directory ); } );
         m_browserDirty = false;
     }
 
@@ -96,12 +108,14 @@ namespace nfx::vista
         return &m_activeProject.value();
     }
 
-    void ProjectManager::render()
+    bool ProjectManager::render()
     {
+        auto trace = Tracer::scope( "ProjectManager::render", "ui" );
+
         if( !ImGui::Begin( "Project Manager" ) )
         {
             ImGui::End();
-            return;
+            return false;
         }
 
         renderToolbar();
@@ -126,6 +140,7 @@ namespace nfx::vista
         renderSaveAsDialog();
 
         ImGui::End();
+        return true;
     }
 
     void ProjectManager::renderToolbar()
@@ -347,7 +362,7 @@ namespace nfx::vista
 
         if( m_browserDirty )
         {
-            refreshBrowserEntries();
+            requestBrowserListing();
         }
 
         // Current directory display
@@ -360,26 +375,34 @@ namespace nfx::vista
         const float listHeight = 270.0f;
         ImGui::BeginChild( "##browserList", ImVec2( 0, listHeight ), true );
 
-        for( const auto& entry : m_browserEntries )
+        const auto listing = m_browserListing.latest();
+        if( !listing || listing->directory != m_browserCurrentDir )
+        {
+            ImGui::TextDisabled( "Reading directory..." );
+        }
+        else
         {
-            const std::string label = entry.isDirectory ? ( "[DIR]  " + entry.name ) : ( "       " + entry.name );
+            for( const auto& entry : listing->entries )
+            {
+                const std::string label = entry.isDirectory ? ( "[DIR]  " + entry.name ) : ( "       " + entry.name );
 
-            bool selected = !entry.isDirectory && ( m_browserFileName == entry.name );
+                bool selected = !entry.isDirectory && ( m_browserFileName == entry.name );
 
-            if( ImGui::Selectable( label.c_str(), selected, ImGuiSelectableFlags_AllowDoubleClick ) )
-            {
-                if( entry.isDirectory )
+                if( ImGui::Selectable( label.c_str(), selected, ImGuiSelectableFlags_AllowDoubleClick ) )
                 {
-                    if( ImGui::IsMouseDoubleClicked( 0 ) )
+                    if( entry.isDirectory )
                     {
-                        m_browserCurrentDir = entry.fullPath;
-                        m_browserDirty = true;
-                        m_browserFileName.clear();
+                        if( ImGui::IsMouseDoubleClicked( 0 ) )
+                        {
+                            m_browserCurrentDir = entry.fullPath;
+                            m_browserDirty = true;
+                            m_browserFileName.clear();
+                        }
+                    }
+                    else
+                    {
+                        m_browserFileName = entry.name;
                     }
-                }
-                else
-                {
-                    m_browserFileName = entry.name;
                 }
             }
         }
@@ -439,7 +462,7 @@ namespace nfx::vista
 
         if( m_browserDirty )
         {
-            refreshBrowserEntries();
+            requestBrowserListing();
         }
 
         // Current directory display
@@ -452,25 +475,33 @@ namespace nfx::vista
         const float listHeight = 250.0f;
         ImGui::BeginChild( "##browserListSave", ImVec2( 0, listHeight ), true );
 
-        for( const auto& entry : m_browserEntries )
+        const auto listing = m_browserListing.latest();
+        if( !listing || listing->directory != m_browserCurrentDir )
         {
-            const std::string label = entry.isDirectory ? ( "[DIR]  " + entry.name ) : ( "       " + entry.name );
+            ImGui::TextDisabled( "Reading directory..." );
+        }
+        else
+        {
+            for( const auto& entry : listing->entries )
+            {
+                const std::string label = entry.isDirectory ? ( "[DIR]  " + entry.name ) : ( "       " + entry.name );
 
-            bool selected = !entry.isDirectory && ( m_browserFileName == entry.name );
+                bool selected = !entry.isDirectory && ( m_browserFileName == entry.name );
 
-            if( ImGui::Selectable( label.c_str(), selected, ImGuiSelectableFlags_AllowDoubleClick ) )
-            {
-                if( entry.isDirectory )
+                if( ImGui::Selectable( label.c_str(), selected, ImGuiSelectableFlags_AllowDoubleClick ) )
                 {
-                    if( ImGui::IsMouseDoubleClicked( 0 ) )
+                    if( entry.isDirectory )
                     {
-                        m_browserCurrentDir = entry.fullPath;
-                        m_browserDirty = true;
+                        if( ImGui::IsMouseDoubleClicked( 0 ) )
+                        {
+                            m_browserCurrentDir = entry.fullPath;
+                            m_browserDirty = true;
+                        }
+                    }
+                    else
+                    {
+                        m_browserFileName = entry.name;
                     }
-                }
-                else
-                {
-                    m_browserFileName = entry.name;
                 }
             }
         }